@@ -0,0 +1,105 @@
+/*
+  ==============================================================================
+
+    AutoGainTables.cpp
+    Created: 19 Oct 2026 11:34:02pm
+    Author:  kylew
+
+  ==============================================================================
+*/
+
+#include "AutoGainTables.h"
+
+namespace
+{
+    //eight whole cycles, so the measured RMS doesn't depend on where the sine was cut off
+    constexpr int measureLength = 512;
+    constexpr int measurePeriod = 64;
+}
+
+AutoGainTables::AutoGainTables()
+    : juce::Thread("Auto Gain Tables")
+{
+    startThread(juce::Thread::Priority::low);
+}
+
+AutoGainTables::~AutoGainTables()
+{
+    stopThread(2000);
+}
+
+float AutoGainTables::getMakeupDecibels(int curve, float drive, float inputLevel) const noexcept
+{
+    if (! ready.load(std::memory_order_acquire))
+        return 0;
+
+    auto& descriptor = CurveRegistry::getCurve(curve);
+    auto& table = tables[(size_t)juce::jlimit(0, CurveRegistry::numCurves - 1, curve)];
+
+    auto drivePos = juce::jlimit(0.f, (float)(numDriveSteps - 1),
+                                 juce::jmap(drive, descriptor.minDrive, descriptor.maxDrive, 0.f, (float)(numDriveSteps - 1)));
+    auto levelPos = juce::jlimit(0.f, (float)(numLevelSteps - 1),
+                                 juce::jmap(inputLevel, minLevel, maxLevel, 0.f, (float)(numLevelSteps - 1)));
+
+    auto d = juce::jmin((int)drivePos, numDriveSteps - 2);
+    auto l = juce::jmin((int)levelPos, numLevelSteps - 2);
+    auto df = drivePos - (float)d;
+    auto lf = levelPos - (float)l;
+
+    auto* row = table.data() + d * numLevelSteps + l;
+    auto low = row[0] + lf * (row[1] - row[0]);
+    auto high = row[numLevelSteps] + lf * (row[numLevelSteps + 1] - row[numLevelSteps]);
+
+    return low + df * (high - low);
+}
+
+void AutoGainTables::run()
+{
+    for (int curve = 0; curve < CurveRegistry::numCurves; ++curve)
+    {
+        if (threadShouldExit())
+            return;
+
+        measure(curve);
+    }
+
+    ready.store(true, std::memory_order_release);
+}
+
+void AutoGainTables::measure(int curve)
+{
+    auto& descriptor = CurveRegistry::getCurve(curve);
+    auto& table = tables[(size_t)curve];
+
+    std::array<float, measureLength> sine, buffer;
+
+    for (int s = 0; s < measureLength; ++s)
+        sine[s] = std::sin(juce::MathConstants<float>::twoPi * (float)s / (float)measurePeriod);
+
+    for (int d = 0; d < numDriveSteps; ++d)
+    {
+        auto drive = juce::jmap((float)d, 0.f, (float)(numDriveSteps - 1), descriptor.minDrive, descriptor.maxDrive);
+        auto coefficients = descriptor.prepare(drive);
+
+        for (int l = 0; l < numLevelSteps; ++l)
+        {
+            auto level = juce::jmap((float)l, 0.f, (float)(numLevelSteps - 1), minLevel, maxLevel);
+            auto amplitude = juce::Decibels::decibelsToGain(level) * juce::MathConstants<float>::sqrt2;
+
+            for (int s = 0; s < measureLength; ++s)
+                buffer[s] = sine[s] * amplitude;
+
+            descriptor.process(buffer.data(), measureLength, coefficients);
+
+            auto sum = 0.f;
+            for (auto sample : buffer)
+                sum += sample * sample;
+
+            //a curve that mutes this level entirely gets no makeup rather than the maximum
+            auto outputLevel = juce::Decibels::gainToDecibels(std::sqrt(sum / measureLength), -200.f);
+            auto makeup = outputLevel > -100.f ? level - outputLevel : 0.f;
+
+            table[(size_t)(d * numLevelSteps + l)] = juce::jlimit(-maxMakeup, maxMakeup, makeup);
+        }
+    }
+}
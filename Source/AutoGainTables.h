@@ -0,0 +1,47 @@
+/*
+  ==============================================================================
+
+    AutoGainTables.h
+    Created: 19 Oct 2026 11:34:02pm
+    Author:  kylew
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "CurveRegistry.h"
+
+//==============================================================================
+/** Makeup gain for every curve over its drive range and the level going into it, so auto gain
+    is one interpolated lookup per block instead of another loudness measurement.
+
+    The tables are measured once per process with a sine through each curve, on a background
+    thread the first time an instance is created. Until they're done the makeup is 0 dB.
+*/
+class AutoGainTables : private juce::Thread
+{
+public:
+    AutoGainTables();
+    ~AutoGainTables() override;
+
+    static constexpr int numDriveSteps = 33;
+    static constexpr int numLevelSteps = 25;
+    static constexpr float minLevel = -60.f; //RMS at the shaper input in dB, clamped to this range
+    static constexpr float maxLevel = 12.f;
+    static constexpr float maxMakeup = 24.f; //dB either way
+
+    //Audio thread: gain in dB that brings the curve's output back to its input level.
+    float getMakeupDecibels(int curve, float drive, float inputLevel) const noexcept;
+
+private:
+    void run() override;
+    void measure(int curve);
+
+    using Table = std::array<float, numDriveSteps * numLevelSteps>; //drive major, in dB
+
+    std::array<Table, CurveRegistry::numCurves> tables{};
+    std::atomic<bool> ready{ false };
+
+    JUCE_DECLARE_NON_COPYABLE(AutoGainTables)
+};
@@ -0,0 +1,76 @@
+/*
+  ==============================================================================
+
+    ChannelInterleavedBlock.cpp
+    Created: 20 Oct 2026 4:02:19am
+    Author:  kylew
+
+  ==============================================================================
+*/
+
+#include "ChannelInterleavedBlock.h"
+
+void ChannelInterleavedBlock::prepare(int maxChannels, int maxSamples)
+{
+    maxNumChannels = juce::jmax(1, maxChannels);
+    capacity = juce::jmax(1, maxSamples);
+
+    storage.assign((size_t)((maxNumChannels + lanes - 1) / lanes) * (size_t)capacity, Vec::expand(0));
+    numChannels = numSamples = 0;
+}
+
+void ChannelInterleavedBlock::interleave(const juce::dsp::AudioBlock<float>& source) noexcept
+{
+    jassert((int)source.getNumChannels() <= maxNumChannels && (int)source.getNumSamples() <= capacity);
+
+    numChannels = juce::jmin((int)source.getNumChannels(), maxNumChannels);
+    numSamples = juce::jmin((int)source.getNumSamples(), capacity);
+
+    for (int start = 0; start < numSamples; start += tileSize)
+    {
+        auto length = juce::jmin(tileSize, numSamples - start);
+
+        for (int group = 0; group < getNumGroups(); ++group)
+        {
+            auto* destination = getGroup(group) + start * lanes;
+
+            for (int lane = 0; lane < lanes; ++lane)
+            {
+                auto channel = group * lanes + lane;
+
+                if (channel < numChannels)
+                {
+                    auto* samples = source.getChannelPointer((size_t)channel) + start;
+
+                    for (int s = 0; s < length; ++s)
+                        destination[s * lanes + lane] = samples[s];
+                }
+                else
+                {
+                    for (int s = 0; s < length; ++s)
+                        destination[s * lanes + lane] = 0;
+                }
+            }
+        }
+    }
+}
+
+void ChannelInterleavedBlock::deinterleave(const juce::dsp::AudioBlock<float>& destination) const noexcept
+{
+    auto numDestinationChannels = juce::jmin((int)destination.getNumChannels(), numChannels);
+    auto numDestinationSamples = juce::jmin((int)destination.getNumSamples(), numSamples);
+
+    for (int start = 0; start < numDestinationSamples; start += tileSize)
+    {
+        auto length = juce::jmin(tileSize, numDestinationSamples - start);
+
+        for (int channel = 0; channel < numDestinationChannels; ++channel)
+        {
+            auto* source = getGroup(channel / lanes) + start * lanes + channel % lanes;
+            auto* samples = destination.getChannelPointer((size_t)channel) + start;
+
+            for (int s = 0; s < length; ++s)
+                samples[s] = source[s * lanes];
+        }
+    }
+}
@@ -0,0 +1,51 @@
+/*
+  ==============================================================================
+
+    ChannelInterleavedBlock.h
+    Created: 20 Oct 2026 4:02:19am
+    Author:  kylew
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+//==============================================================================
+/** The host's planar channels transposed so channels sit side by side, for stages that
+    have a recursion per channel and so can't be vectorized along time.
+
+    Channels are split into groups of one SIMDRegister's width. Each group is a run of
+    registers, one per sample, with lane n holding channel group * lanes + n, so a filter
+    steps every channel of a group with one instruction per operation. Lanes past the last
+    channel are kept at zero.
+
+    The transposes go through short tiles of samples so the reads from every channel and
+    the writes into the group all stay in L1.
+*/
+class ChannelInterleavedBlock
+{
+public:
+    using Vec = juce::dsp::SIMDRegister<float>;
+    static constexpr int lanes = (int)Vec::SIMDNumElements;
+    static constexpr int tileSize = 64;
+
+    //Allocates for the largest block, nothing is allocated after this.
+    void prepare(int maxChannels, int maxSamples);
+
+    void interleave(const juce::dsp::AudioBlock<float>& source) noexcept;
+    void deinterleave(const juce::dsp::AudioBlock<float>& destination) const noexcept;
+
+    int getNumChannels() const noexcept { return numChannels; }
+    int getNumGroups() const noexcept { return (numChannels + lanes - 1) / lanes; }
+    int getNumSamples() const noexcept { return numSamples; }
+
+    //lanes floats per sample, aligned for Vec::fromRawArray
+    float* getGroup(int group) noexcept { return reinterpret_cast<float*>(storage.data() + (size_t)group * (size_t)capacity); }
+    const float* getGroup(int group) const noexcept { return reinterpret_cast<const float*>(storage.data() + (size_t)group * (size_t)capacity); }
+
+private:
+    std::vector<Vec> storage; //group after group, capacity registers each
+    int capacity = 0, maxNumChannels = 0;
+    int numChannels = 0, numSamples = 0;
+};
@@ -0,0 +1,356 @@
+/*
+  ==============================================================================
+
+    CurveKernels.h
+    Created: 19 Oct 2026 2:41:07pm
+    Author:  kylew
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+//==============================================================================
+/** Per-drive constants of a curve. prepare() fills them once per block so the
+    per-sample shape() is left with multiplies, adds and selects.
+*/
+struct CurveCoefficients
+{
+    float drive = 1;
+    std::array<float, 6> c{};
+};
+
+/** Each kernel is a struct with two static functions:
+
+        static CurveCoefficients prepare(float drive);
+        static float shape(float x, const CurveCoefficients&) noexcept;
+
+    shape() gets inlined into processCurve<Kernel>, so keeping it free of branches
+    and library calls is what lets the compiler vectorize the loop.
+*/
+namespace CurveKernels
+{
+    //sin(pi * d) / (d * (1 - d)) sampled over the whole drive range. 1 / sin(pi * d) itself blows up at
+    //both ends and interpolates badly there; this ratio is smooth and bounded (pi at the ends, 4 in
+    //the middle), so a lerp between entries is accurate at any drive, on the parameter grid or not.
+    constexpr int sineTableSize = 128;
+
+    inline const std::array<float, sineTableSize + 2> sineTable = []
+    {
+        std::array<float, sineTableSize + 2> table{};
+
+        for (int i = 0; i <= sineTableSize; ++i)
+        {
+            auto d = (double)i / sineTableSize;
+            table[(size_t)i] = i == 0 || i == sineTableSize ? juce::MathConstants<float>::pi
+                                                            : (float)(std::sin(juce::MathConstants<double>::pi * d) / (d * (1 - d)));
+        }
+
+        table[sineTableSize + 1] = table[sineTableSize]; //so the lerp can always read one past its index
+        return table;
+    }();
+
+    //sin(pi * drive * x) / sin(pi * drive), held at full scale past 1 / drive, mirrored for negative input
+    struct Sine
+    {
+        static CurveCoefficients prepare(float drive)
+        {
+            drive = juce::jlimit(.01f, .99f, drive);
+
+            auto position = drive * sineTableSize;
+            auto index = (int)position;
+            auto ratio = sineTable[(size_t)index] + (position - (float)index) * (sineTable[(size_t)index + 1] - sineTable[(size_t)index]);
+
+            CurveCoefficients k;
+            k.drive = drive;
+            k.c[0] = juce::MathConstants<float>::pi * drive;
+            k.c[1] = 1 / (ratio * drive * (1 - drive));
+            k.c[2] = 1 / drive;
+            return k;
+        }
+
+        static float shape(float x, const CurveCoefficients& k) noexcept
+        {
+            auto ax = std::abs(x);
+
+            //the argument is at most pi, and sin(t) = sin(pi - t) folds it into [0, pi / 2] for the polynomial.
+            //Past 1 / drive it sits at pi, which folds to 0, so the sine vanishes and only the held 1 is left.
+            auto t = k.c[0] * juce::jmin(ax, k.c[2]);
+            t = juce::jmin(t, juce::MathConstants<float>::pi - t);
+
+            auto t2 = t * t;
+            auto sine = t * (1.f + t2 * (-1.6666667e-1f + t2 * (8.3333333e-3f + t2 * (-1.9841270e-4f + t2 * (2.7557319e-6f + t2 * -2.5052108e-8f)))));
+
+            //a select between constants, so the whole sine is computed unconditionally and the loop stays branch free
+            auto held = ax > k.c[2] ? 1.f : 0.f;
+
+            return std::copysign(sine * k.c[1] + held, x);
+        }
+    };
+
+    struct Quadratic
+    {
+        static CurveCoefficients prepare(float drive)
+        {
+            CurveCoefficients k;
+            k.drive = drive;
+            k.c[0] = drive;
+            k.c[1] = drive - 1;
+            return k;
+        }
+
+        static float shape(float x, const CurveCoefficients& k) noexcept
+        {
+            auto ax = std::abs(x);
+            return x * (ax + k.c[0]) / (x * x + k.c[1] * ax + 1);
+        }
+    };
+
+    struct Factor
+    {
+        static CurveCoefficients prepare(float drive)
+        {
+            auto factor = 2 * drive / (1 - drive);
+
+            CurveCoefficients k;
+            k.drive = drive;
+            k.c[0] = 1 + factor;
+            k.c[1] = factor;
+            return k;
+        }
+
+        static float shape(float x, const CurveCoefficients& k) noexcept
+        {
+            return (k.c[0] * x) / (1 + k.c[1] * std::abs(x));
+        }
+    };
+
+    struct GloubiBoulga
+    {
+        static CurveCoefficients prepare(float drive)
+        {
+            CurveCoefficients k;
+            k.drive = drive;
+            k.c[0] = drive;
+            return k;
+        }
+
+        static float shape(float x, const CurveCoefficients& k) noexcept
+        {
+            auto distort = x * k.c[0];
+            auto magnitude = std::abs(distort);
+            auto constant = 1 + std::exp(std::sqrt(magnitude) * -0.75f);
+
+            //(e^d - e^(-d * constant)) / (e^d + e^-d) with every term divided by e^|d|, so no exponent is ever
+            //positive enough to overflow. Left as it was, float exp runs out past |d| = 88 and gives inf / inf.
+            auto decay = std::exp(-2 * magnitude);
+            auto positive = distort >= 0;
+            auto up = positive ? 1.f : decay;
+            auto down = positive ? decay : 1.f;
+
+            return (up - std::exp(-distort * constant - magnitude)) / (up + down);
+        }
+    };
+
+    //tanh(drive * x) / tanh(drive), using the Pade approximation so the loop vectorizes
+    struct Tanh
+    {
+        static CurveCoefficients prepare(float drive)
+        {
+            CurveCoefficients k;
+            k.drive = drive;
+            k.c[0] = drive;
+            k.c[1] = 1 / juce::dsp::FastMathApproximations::tanh(juce::jlimit(-5.f, 5.f, drive));
+            return k;
+        }
+
+        static float shape(float x, const CurveCoefficients& k) noexcept
+        {
+            //the approximation is only good for |x| < 5, and tanh is flat by then anyway
+            auto driven = juce::jlimit(-5.f, 5.f, x * k.c[0]);
+            return juce::dsp::FastMathApproximations::tanh(driven) * k.c[1];
+        }
+    };
+
+    //atan(drive * x) / atan(drive), with a polynomial atan on [0, 1] and the reciprocal identity above it
+    struct Arctan
+    {
+        static CurveCoefficients prepare(float drive)
+        {
+            CurveCoefficients k;
+            k.drive = drive;
+            k.c[0] = drive;
+            k.c[1] = 1 / std::atan(drive);
+            return k;
+        }
+
+        static float shape(float x, const CurveCoefficients& k) noexcept
+        {
+            auto driven = x * k.c[0];
+            auto ax = std::abs(driven);
+            auto above = ax > 1.f;
+            auto t = above ? 1 / ax : ax;
+            auto t2 = t * t;
+
+            auto poly = t * (0.99997726f + t2 * (-0.33262347f + t2 * (0.19354346f + t2 * (-0.11643287f + t2 * (0.05265332f + t2 * -0.01172120f)))));
+            auto angle = above ? juce::MathConstants<float>::halfPi - poly : poly;
+
+            return std::copysign(angle, driven) * k.c[1];
+        }
+    };
+
+    struct HardClip
+    {
+        static CurveCoefficients prepare(float drive)
+        {
+            CurveCoefficients k;
+            k.drive = drive;
+            k.c[0] = drive;
+            return k;
+        }
+
+        static float shape(float x, const CurveCoefficients& k) noexcept
+        {
+            return juce::jlimit(-1.f, 1.f, x * k.c[0]);
+        }
+    };
+
+    //drive * x folded back into [-1, 1] as a triangle wave
+    struct Foldback
+    {
+        static CurveCoefficients prepare(float drive)
+        {
+            CurveCoefficients k;
+            k.drive = drive;
+            k.c[0] = drive;
+            return k;
+        }
+
+        static float shape(float x, const CurveCoefficients& k) noexcept
+        {
+            auto u = (x * k.c[0] + 1) * .25f;
+            auto phase = u - std::floor(u);
+
+            return 1 - std::abs(phase * 4 - 2);
+        }
+    };
+
+    //First harmonic plus drive-weighted Chebyshev polynomials T2..T5, collapsed into one power series
+    //per block and evaluated with Horner. Even harmonics are offset so silence stays silent.
+    struct Chebyshev
+    {
+        static CurveCoefficients prepare(float drive)
+        {
+            //power series coefficients of T1, T2 - T2(0), T3, T4 - T4(0), T5
+            constexpr float t[5][6] = { { 0, 1,   0,   0, 0,  0 },
+                                        { 0, 0,   2,   0, 0,  0 },
+                                        { 0, -3,  0,   4, 0,  0 },
+                                        { 0, 0,  -8,   0, 8,  0 },
+                                        { 0, 5,   0, -20, 0, 16 } };
+
+            CurveCoefficients k;
+            k.drive = drive;
+
+            for (int n = 0; n < 5; ++n)
+            {
+                auto weight = n == 0 ? 1.f : drive / (float)(n + 1);
+
+                for (int i = 0; i < 6; ++i)
+                    k.c[i] += weight * t[n][i];
+            }
+
+            auto evaluate = [&k](float x) { return k.c[0] + x * (k.c[1] + x * (k.c[2] + x * (k.c[3] + x * (k.c[4] + x * k.c[5])))); };
+            auto norm = 1 / juce::jmax(std::abs(evaluate(1.f)), std::abs(evaluate(-1.f)));
+
+            for (auto& c : k.c)
+                c *= norm;
+
+            return k;
+        }
+
+        static float shape(float x, const CurveCoefficients& k) noexcept
+        {
+            //the polynomials are only bounded on [-1, 1]
+            x = juce::jlimit(-1.f, 1.f, x);
+            return k.c[0] + x * (k.c[1] + x * (k.c[2] + x * (k.c[3] + x * (k.c[4] + x * k.c[5]))));
+        }
+    };
+}
+
+//==============================================================================
+template <typename Kernel>
+void processCurve(float* data, int numSamples, const CurveCoefficients& coefficients) noexcept
+{
+    //local copy so the compiler knows the coefficients can't alias the audio
+    const auto k = coefficients;
+
+    for (int s = 0; s < numSamples; ++s)
+        data[s] = Kernel::shape(data[s], k);
+}
+
+//Both curves and the crossfade between them in one pass. The morph position ramps linearly across the
+//block so it can be computed from the sample index instead of being read from a buffer.
+template <typename KernelA, typename KernelB>
+void processMorph(float* data, int numSamples, const CurveCoefficients& coefficientsA, const CurveCoefficients& coefficientsB,
+                  float morphStart, float morphStep) noexcept
+{
+    const auto ka = coefficientsA;
+    const auto kb = coefficientsB;
+
+    for (int s = 0; s < numSamples; ++s)
+    {
+        auto a = KernelA::shape(data[s], ka);
+        auto b = KernelB::shape(data[s], kb);
+
+        data[s] = a + (morphStart + (float)s * morphStep) * (b - a);
+    }
+}
+
+//Mid/side encode, a curve on each and the decode in one pass over the stereo pair. The two curves differ, so the
+//loop vectorizes along time with mid and side as two independent streams rather than as lanes of one register.
+template <typename MidKernel, typename SideKernel>
+void processMidSide(float* left, float* right, int numSamples, const CurveCoefficients& midCoefficients, const CurveCoefficients& sideCoefficients) noexcept
+{
+    const auto km = midCoefficients;
+    const auto ks = sideCoefficients;
+
+    for (int s = 0; s < numSamples; ++s)
+    {
+        auto mid = MidKernel::shape((left[s] + right[s]) * .5f, km);
+        auto side = SideKernel::shape((left[s] - right[s]) * .5f, ks);
+
+        left[s] = mid + side;
+        right[s] = mid - side;
+    }
+}
+
+//Drive that moves every sample. Coefficients are prepared only at the ends of each short segment and ramped
+//linearly in between, so the per-sample cost stays a handful of adds instead of a sin or a divide.
+template <typename Kernel>
+void processCurveModulated(float* data, int numSamples, const float* drive) noexcept
+{
+    constexpr int segmentSize = 16;
+
+    auto k = Kernel::prepare(drive[0]);
+
+    for (int start = 0; start < numSamples; start += segmentSize)
+    {
+        auto length = juce::jmin(segmentSize, numSamples - start);
+        auto end = Kernel::prepare(drive[start + length - 1]);
+
+        std::array<float, 6> step;
+        for (size_t i = 0; i < step.size(); ++i)
+            step[i] = (end.c[i] - k.c[i]) / (float)length;
+
+        for (int s = start; s < start + length; ++s)
+        {
+            for (size_t i = 0; i < step.size(); ++i)
+                k.c[i] += step[i];
+
+            data[s] = Kernel::shape(data[s], k);
+        }
+
+        k = end;
+    }
+}
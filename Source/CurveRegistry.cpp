@@ -0,0 +1,120 @@
+/*
+  ==============================================================================
+
+    CurveRegistry.cpp
+    Created: 19 Oct 2026 2:41:07pm
+    Author:  kylew
+
+  ==============================================================================
+*/
+
+#include "CurveRegistry.h"
+
+namespace
+{
+    //same order as the curves table below
+    using Kernels = std::tuple<CurveKernels::Sine,
+                               CurveKernels::Quadratic,
+                               CurveKernels::Factor,
+                               CurveKernels::GloubiBoulga,
+                               CurveKernels::Tanh,
+                               CurveKernels::Arctan,
+                               CurveKernels::HardClip,
+                               CurveKernels::Foldback,
+                               CurveKernels::Chebyshev>;
+
+    static_assert(std::tuple_size<Kernels>::value == CurveRegistry::numCurves, "every curve needs a kernel");
+
+    template <size_t from, size_t... to>
+    constexpr std::array<MorphFunction, CurveRegistry::numCurves> makeMorphRow(std::index_sequence<to...>)
+    {
+        return { &processMorph<std::tuple_element_t<from, Kernels>, std::tuple_element_t<to, Kernels>>... };
+    }
+
+    template <size_t... from>
+    constexpr std::array<std::array<MorphFunction, CurveRegistry::numCurves>, CurveRegistry::numCurves> makeMorphTable(std::index_sequence<from...>)
+    {
+        return { makeMorphRow<from>(std::make_index_sequence<CurveRegistry::numCurves>())... };
+    }
+
+    template <size_t mid, size_t... side>
+    constexpr std::array<MidSideFunction, CurveRegistry::numCurves> makeMidSideRow(std::index_sequence<side...>)
+    {
+        return { &processMidSide<std::tuple_element_t<mid, Kernels>, std::tuple_element_t<side, Kernels>>... };
+    }
+
+    template <size_t... mid>
+    constexpr std::array<std::array<MidSideFunction, CurveRegistry::numCurves>, CurveRegistry::numCurves> makeMidSideTable(std::index_sequence<mid...>)
+    {
+        return { makeMidSideRow<mid>(std::make_index_sequence<CurveRegistry::numCurves>())... };
+    }
+
+    const auto midSideFunctions = makeMidSideTable(std::make_index_sequence<CurveRegistry::numCurves>());
+
+    //one cache line, so a tile stays in L1 across the stages; long enough to amortize the call per stage
+    constexpr int cascadeTileSize = 16;
+
+    //every pair gets its own instantiation so both kernels inline into one loop
+    const auto morphFunctions = makeMorphTable(std::make_index_sequence<CurveRegistry::numCurves>());
+
+    template <typename Kernel>
+    constexpr CurveDescriptor makeCurve(const char* parameterID, const char* name, float minDrive, float maxDrive, float defaultDrive, float tableRange)
+    {
+        return { parameterID, name, minDrive, maxDrive, .01f, defaultDrive, tableRange,
+                 &Kernel::prepare, &Kernel::shape, &processCurve<Kernel>, &processCurveModulated<Kernel> };
+    }
+
+    const std::array<CurveDescriptor, CurveRegistry::numCurves> curves
+    {
+        //sine jumps to its held value past 1 / drive and chebyshev is clamped at 1, so their tables stop
+        //at 1; hard clip and foldback kink at every drive and stay on their kernels
+        makeCurve<CurveKernels::Sine>("sinDistort", "Sine", .01f, .99f, .5f, 1),
+        makeCurve<CurveKernels::Quadratic>("quadraticDistort", "Quadratic", .01f, 10.f, 1.f, 8),
+        makeCurve<CurveKernels::Factor>("factorDistort", "Factor", .01f, .99f, .5f, 4),
+        makeCurve<CurveKernels::GloubiBoulga>("gbDistort", "Gloubi Boulga", .01f, 10.f, 1.f, 8),
+        makeCurve<CurveKernels::Tanh>("tanhDistort", "Tanh", .01f, 10.f, 1.f, 8),
+        makeCurve<CurveKernels::Arctan>("atanDistort", "Arctan", .01f, 10.f, 1.f, 8),
+        makeCurve<CurveKernels::HardClip>("hardClipDistort", "Hard Clip", .01f, 10.f, 1.f, 0),
+        makeCurve<CurveKernels::Foldback>("foldbackDistort", "Foldback", .01f, 10.f, 1.f, 0),
+        makeCurve<CurveKernels::Chebyshev>("chebyshevDistort", "Chebyshev", .01f, .99f, .5f, 1)
+    };
+}
+
+const std::array<CurveDescriptor, CurveRegistry::numCurves>& CurveRegistry::getCurves()
+{
+    return curves;
+}
+
+const CurveDescriptor& CurveRegistry::getCurve(int index)
+{
+    return curves[(size_t)juce::jlimit(0, numCurves - 1, index)];
+}
+
+MorphFunction CurveRegistry::getMorphFunction(int from, int to)
+{
+    return morphFunctions[(size_t)juce::jlimit(0, numCurves - 1, from)][(size_t)juce::jlimit(0, numCurves - 1, to)];
+}
+
+MidSideFunction CurveRegistry::getMidSideFunction(int mid, int side)
+{
+    return midSideFunctions[(size_t)juce::jlimit(0, numCurves - 1, mid)][(size_t)juce::jlimit(0, numCurves - 1, side)];
+}
+
+void CurveRegistry::processCascade(float* data, int numSamples, const CascadeStage* stages, int numStages) noexcept
+{
+    for (int start = 0; start < numSamples; start += cascadeTileSize)
+    {
+        auto* tile = data + start;
+        auto tileSize = juce::jmin(cascadeTileSize, numSamples - start);
+
+        for (int stage = 0; stage < numStages; ++stage)
+        {
+            auto& current = stages[stage];
+
+            if (current.gain != 1.f)
+                juce::FloatVectorOperations::multiply(tile, current.gain, tileSize);
+
+            current.curve->process(tile, tileSize, current.coefficients);
+        }
+    }
+}
@@ -0,0 +1,76 @@
+/*
+  ==============================================================================
+
+    CurveRegistry.h
+    Created: 19 Oct 2026 2:41:07pm
+    Author:  kylew
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "CurveKernels.h"
+
+//==============================================================================
+/** Everything the plugin needs to know about one shaper curve. The parameter layout,
+    the processBlock dispatch and the editor's drive knob are all built from this.
+*/
+struct CurveDescriptor
+{
+    const char* parameterID;
+    const char* name;
+
+    //drive parameter range. Keep the interval at .01, the shared curve tables are keyed on it.
+    float minDrive, maxDrive, interval, defaultDrive;
+
+    //Inputs up to this magnitude may be served from a shared CurveTable, 0 keeps the curve on its kernel.
+    //Only worth it for curves that are smooth over the whole range, a kink between grid points costs
+    //more error than CurveTable::maxError allows.
+    float tableRange;
+
+    CurveCoefficients (*prepare)(float drive);
+    float (*shapeSample)(float x, const CurveCoefficients&);
+    void (*process)(float* data, int numSamples, const CurveCoefficients&);
+    void (*processModulated)(float* data, int numSamples, const float* drive); //one drive value per sample
+};
+
+using MorphFunction = void (*)(float* data, int numSamples, const CurveCoefficients& from, const CurveCoefficients& to,
+                               float morphStart, float morphStep);
+
+using MidSideFunction = void (*)(float* left, float* right, int numSamples, const CurveCoefficients& mid, const CurveCoefficients& side);
+
+//One stage of a serial cascade, with its coefficients prepared for the block.
+struct CascadeStage
+{
+    const CurveDescriptor* curve;
+    CurveCoefficients coefficients;
+    float gain; //linear gain into the stage
+};
+
+/** To add a curve: write a kernel in CurveKernels.h, add it to the Kernels list and the table in
+    CurveRegistry.cpp and bump numCurves. The order is the curveType order, so only ever append.
+*/
+namespace CurveRegistry
+{
+    constexpr int numCurves = 9;
+    constexpr int numClassicCurves = 4; //the curves typeSelect has always covered
+
+    const std::array<CurveDescriptor, numCurves>& getCurves();
+
+    //index is zero based, the curve parameters are one based
+    const CurveDescriptor& getCurve(int index);
+
+    //fused processMorph for this pair of curves
+    MorphFunction getMorphFunction(int from, int to);
+
+    //fused processMidSide for this pair of curves
+    MidSideFunction getMidSideFunction(int mid, int side);
+
+    //Runs every stage over a short tile before moving on to the next one. Each stage is still its own
+    //call through the descriptor and reads and writes the tile through memory, but the tile is 64 bytes
+    //and never leaves L1 between stages. Not a fused per-sample loop: the stage curves are only known
+    //at runtime, and templating every combination the way processMorph does pairs would take 9^4
+    //instantiations.
+    void processCascade(float* data, int numSamples, const CascadeStage* stages, int numStages) noexcept;
+}
@@ -0,0 +1,194 @@
+/*
+  ==============================================================================
+
+    CurveTableCache.cpp
+    Created: 19 Oct 2026 9:12:40am
+    Author:  kylew
+
+  ==============================================================================
+*/
+
+#include "CurveTableCache.h"
+
+namespace
+{
+    //How long a table nobody is using stays in the cache before it gets freed.
+    constexpr juce::uint32 evictTimeMs = 10000;
+}
+
+//==============================================================================
+CurveTable::CurveTable(juce::uint32 tableKey, ShapeFunction shape, float inputRange)
+    : key(tableKey), range(inputRange)
+{
+    if (range <= 0)
+        return;
+
+    auto type = CurveTableCache::getType(key);
+    auto drive = CurveTableCache::getDrive(key);
+
+    for (int i = 0; i < size; ++i)
+        values[i] = getInput(i, range);
+
+    shape(type, drive, values.data(), size);
+    values[size] = values[size - 1];
+
+    //halfway between points in u is as far from the grid as an input gets; the grid is fine enough
+    //that the error of a smooth curve peaks there
+    std::vector<float> inputs(size - 1), exact(size - 1);
+
+    for (int i = 0; i < size - 1; ++i)
+        inputs[i] = exact[i] = range * (float)(i - half + .5) * std::abs((float)(i - half + .5)) / (float)(half * half);
+
+    shape(type, drive, exact.data(), size - 1);
+    lookup(inputs.data(), size - 1);
+
+    auto worst = 0.f;
+
+    for (int i = 0; i < size - 1; ++i)
+        worst = std::fmax(worst, std::abs(inputs[i] - exact[i]));
+
+    accurate = worst <= maxError;
+}
+
+float CurveTable::getInput(int index, float range) noexcept
+{
+    auto u = (float)(index - half) / (float)half;
+    return range * u * std::abs(u);
+}
+
+bool CurveTable::process(float* data, int numSamples) const noexcept
+{
+    if (! accurate)
+        return false;
+
+    //one pass to check the whole block fits, NaN fails it too
+    auto outside = 0;
+
+    for (int s = 0; s < numSamples; ++s)
+        outside += std::abs(data[s]) <= range ? 0 : 1;
+
+    if (outside > 0)
+        return false;
+
+    lookup(data, numSamples);
+    return true;
+}
+
+void CurveTable::lookup(float* data, int numSamples) const noexcept
+{
+    auto scale = 1 / range;
+
+    for (int s = 0; s < numSamples; ++s)
+    {
+        auto u = std::copysign(std::sqrt(std::abs(data[s]) * scale), data[s]);
+        auto pos = (u + 1) * (float)half;
+        auto index = (int)pos;
+        auto frac = pos - (float)index;
+
+        data[s] = values[index] + frac * (values[index + 1] - values[index]);
+    }
+}
+
+//==============================================================================
+CurveTableCache::CurveTableCache()
+{
+    thread.addTimeSliceClient(this);
+    thread.startThread(juce::Thread::Priority::low);
+}
+
+CurveTableCache::~CurveTableCache()
+{
+    thread.removeTimeSliceClient(this);
+    thread.stopThread(2000);
+}
+
+juce::uint32 CurveTableCache::makeKey(int type, float drive) noexcept
+{
+    auto driveStep = (juce::uint32)juce::jlimit(0, 0xfffe, juce::roundToInt(drive * 100.f));
+    return ((juce::uint32)type << 16) | driveStep;
+}
+
+CurveTable::Ptr CurveTableCache::acquire(juce::uint32 key, CurveTable::ShapeFunction shape, float range)
+{
+    const juce::ScopedLock sl(lock);
+
+    for (auto* table : tables)
+        if (table->key == key)
+            return table;
+
+    return tables.add(new CurveTable(key, shape, range));
+}
+
+int CurveTableCache::useTimeSlice()
+{
+    const juce::ScopedLock sl(lock);
+    auto now = juce::Time::getMillisecondCounter();
+
+    for (int i = tables.size(); --i >= 0;)
+    {
+        auto* table = tables.getUnchecked(i);
+
+        //the cache's own reference is the only one left, so no instance is using it
+        if (table->getReferenceCount() == 1)
+        {
+            if (table->lastUsed == 0)
+                table->lastUsed = now;
+            else if (now - table->lastUsed > evictTimeMs)
+                tables.remove(i);
+        }
+        else
+        {
+            table->lastUsed = 0;
+        }
+    }
+
+    return 1000;
+}
+
+//==============================================================================
+CurveTableCache::Handle::Handle(CurveTable::ShapeFunction shapeFunction, CurveTable::RangeFunction rangeFunction)
+    : shape(shapeFunction), range(rangeFunction)
+{
+    cache->thread.addTimeSliceClient(this);
+}
+
+CurveTableCache::Handle::~Handle()
+{
+    cache->thread.removeTimeSliceClient(this);
+}
+
+const CurveTable* CurveTableCache::Handle::getTable(juce::uint32 key) const noexcept
+{
+    //seq_cst pairs with the swap in useTimeSlice: a block that started after the swap was seen can't get the old table
+    auto* table = published.load(std::memory_order_seq_cst);
+    return (table != nullptr && table->key == key) ? table : nullptr;
+}
+
+int CurveTableCache::Handle::useTimeSlice()
+{
+    //A retired table was published until the block in progress when it was swapped out. Once a later
+    //block has started, that one is done and nothing can still hold it. An audio thread that stops
+    //calling keeps its old tables alive until it starts again or the handle goes.
+    auto block = blockCount.load(std::memory_order_seq_cst);
+
+    retired.erase(std::remove_if(retired.begin(), retired.end(),
+                                 [block](const Retired& r) { return block != r.block; }),
+                  retired.end());
+
+    auto key = requestedKey.load(std::memory_order_relaxed);
+
+    if (key == invalidKey || (current != nullptr && current->key == key))
+        return 10;
+
+    auto table = cache->acquire(key, shape, range(getType(key)));
+    auto previous = current;
+
+    current = table;
+    published.store(current.get(), std::memory_order_seq_cst);
+
+    //read after the store, so the block counted here is the last one that could have seen the old table
+    if (previous != nullptr)
+        retired.push_back({ previous, blockCount.load(std::memory_order_seq_cst) });
+
+    return 0;
+}
@@ -0,0 +1,131 @@
+/*
+  ==============================================================================
+
+    CurveTableCache.h
+    Created: 19 Oct 2026 9:12:40am
+    Author:  kylew
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+//Build with WAVESHAPER_CURVE_TABLES=1 to serve the smooth curves from the shared tables. Off until
+//GraphRender --table-benchmark shows the lookup beating the kernels, which are a handful of
+//multiplies for most curves against a sqrt, a divide and two dependent loads per sample.
+#ifndef WAVESHAPER_CURVE_TABLES
+ #define WAVESHAPER_CURVE_TABLES 0
+#endif
+
+//==============================================================================
+/** A precomputed transfer curve for one shaper type at one quantized drive value.
+    Tables are immutable once built and are shared by every plugin instance in the process.
+
+    The grid is x = range * u * |u| for u evenly spaced over -1 to 1: it has a point at exactly 0 and
+    gets denser towards it, where quiet signals live and the curves are steepest. Each table measures
+    itself against the exact curve halfway between its points when it's built, and refuses to process
+    anything if it misses by more than maxError, so swapping between table and kernel never steps
+    the output by more than that.
+*/
+struct CurveTable : juce::ReferenceCountedObject
+{
+    using Ptr = juce::ReferenceCountedObjectPtr<CurveTable>;
+    using ShapeFunction = void (*)(int type, float drive, float* data, int numSamples); //shapes data in place
+    using RangeFunction = float (*)(int type); //largest input magnitude the table covers, 0 for no table
+
+    static constexpr int half = 2048;           //points on each side of 0
+    static constexpr int size = 2 * half + 1;
+    static constexpr float maxError = 1.0e-4f;  //-80 dB
+
+    CurveTable(juce::uint32 tableKey, ShapeFunction shape, float inputRange);
+
+    //Interpolated lookup, in place. Returns false and leaves data alone when the table missed maxError
+    //or any sample is outside its range, in which case the caller runs the kernel. Safe to call from any thread.
+    bool process(float* data, int numSamples) const noexcept;
+
+    const juce::uint32 key;
+    const float range;
+
+private:
+    friend class CurveTableCache;
+
+    static float getInput(int index, float range) noexcept;
+    void lookup(float* data, int numSamples) const noexcept; //no checks, every sample has to be in range
+
+    std::array<float, size + 1> values; //last value is repeated so interpolation never reads past the end
+    bool accurate = false;
+    juce::uint32 lastUsed = 0;          //only touched by the cache thread
+
+    JUCE_DECLARE_NON_COPYABLE(CurveTable)
+};
+
+//==============================================================================
+/** Process-wide, reference counted store of CurveTables keyed by shaper type and drive.
+
+    Everything that allocates, locks or frees runs on the cache's own background thread.
+    Instances talk to it through a Handle, whose audio thread side is a pair of atomics.
+*/
+class CurveTableCache : private juce::TimeSliceClient
+{
+public:
+    CurveTableCache();
+    ~CurveTableCache() override;
+
+    static constexpr juce::uint32 invalidKey = 0xffffffff;
+
+    //Drive values are quantized to the .01 step used by the distortion parameters.
+    static juce::uint32 makeKey(int type, float drive) noexcept;
+    static int getType(juce::uint32 key) noexcept    { return (int)(key >> 16); }
+    static float getDrive(juce::uint32 key) noexcept { return (float)(key & 0xffff) * .01f; }
+
+    class Handle : private juce::TimeSliceClient
+    {
+    public:
+        Handle(CurveTable::ShapeFunction shapeFunction, CurveTable::RangeFunction rangeFunction);
+        ~Handle() override;
+
+        //Audio thread: call at the top of every block, before getTable. Starting a block means the last
+        //one is finished with whatever table it got, so tables swapped out before it can go.
+        void startBlock() noexcept { blockCount.fetch_add(1, std::memory_order_seq_cst); }
+
+        //Audio thread: ask for a table. Never blocks, the table turns up on a later block.
+        void request(juce::uint32 key) noexcept { requestedKey.store(key, std::memory_order_relaxed); }
+
+        //Audio thread: returns the table for this key, or nullptr if it isn't ready yet. Only valid
+        //until the next startBlock.
+        const CurveTable* getTable(juce::uint32 key) const noexcept;
+
+    private:
+        int useTimeSlice() override;
+
+        struct Retired
+        {
+            CurveTable::Ptr table;
+            juce::uint32 block; //blockCount right after the swap, the block that may still be reading it
+        };
+
+        juce::SharedResourcePointer<CurveTableCache> cache;
+        CurveTable::ShapeFunction shape;
+        CurveTable::RangeFunction range;
+
+        std::atomic<juce::uint32> requestedKey{ invalidKey };
+        std::atomic<const CurveTable*> published{ nullptr };
+        std::atomic<juce::uint32> blockCount{ 0 };
+
+        CurveTable::Ptr current;
+        std::vector<Retired> retired;
+
+        JUCE_DECLARE_NON_COPYABLE(Handle)
+    };
+
+private:
+    CurveTable::Ptr acquire(juce::uint32 key, CurveTable::ShapeFunction shape, float range);
+    int useTimeSlice() override;
+
+    juce::CriticalSection lock;
+    juce::ReferenceCountedArray<CurveTable> tables;
+    juce::TimeSliceThread thread{ "Curve Table Cache" };
+
+    JUCE_DECLARE_NON_COPYABLE(CurveTableCache)
+};
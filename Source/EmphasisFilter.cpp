@@ -0,0 +1,207 @@
+/*
+  ==============================================================================
+
+    EmphasisFilter.cpp
+    Created: 20 Oct 2026 1:06:12am
+    Author:  kylew
+
+  ==============================================================================
+*/
+
+#include "EmphasisFilter.h"
+
+namespace
+{
+    constexpr float peakQ = .7f;
+    constexpr float shelfRatio = 4.f;   //the high shelf sits two octaves above the peak
+}
+
+void EmphasisFilter::prepare(double sampleRate, int maxChannels, int maxBlockSize)
+{
+    interleaved.prepare(maxChannels, maxBlockSize);
+
+    auto numGroups = (juce::jmax(1, maxChannels) + ChannelInterleavedBlock::lanes - 1) / ChannelInterleavedBlock::lanes;
+    pre.prepare(numGroups);
+    post.prepare(numGroups);
+
+    ramp.resize((size_t)((juce::jmax(1, maxBlockSize) + rampInterval - 1) / rampInterval));
+    numRampSteps = 0;
+
+    rate = sampleRate;
+    gain.reset(sampleRate, rampSeconds);
+    centre.reset(sampleRate, rampSeconds);
+    primed = false; //the next setParameters jumps, and brings new coefficients for the new rate
+    active = false;
+    reset();
+}
+
+void EmphasisFilter::reset() noexcept
+{
+    pre.reset();
+    post.reset();
+
+    if (primed && (gain.isSmoothing() || centre.isSmoothing()))
+    {
+        gain.setCurrentAndTargetValue(gain.getTargetValue());
+        centre.setCurrentAndTargetValue(centre.getTargetValue());
+        updateCoefficients(gain.getTargetValue(), centre.getTargetValue());
+    }
+}
+
+bool EmphasisFilter::setParameters(float gainDecibels, float frequency) noexcept
+{
+    if (! primed)
+    {
+        gain.setCurrentAndTargetValue(gainDecibels);
+        centre.setCurrentAndTargetValue(frequency);
+        updateCoefficients(gainDecibels, frequency);
+        primed = true;
+    }
+    else
+    {
+        gain.setTargetValue(gainDecibels);
+        centre.setTargetValue(frequency);
+    }
+
+    //at 0 dB both sides are unity, so a glide to flat ends exactly where skipping them takes over
+    auto wasActive = active;
+    active = gain.isSmoothing() || gain.getTargetValue() != 0;
+
+    //coming back from flat, the old state is from a different signal
+    if (active && ! wasActive)
+    {
+        pre.reset();
+        post.reset();
+    }
+
+    return active;
+}
+
+void EmphasisFilter::updateCoefficients(float gainDecibels, float frequency) noexcept
+{
+    using Coefficients = juce::dsp::IIR::ArrayCoefficients<float>;
+
+    auto shelfFrequency = juce::jmin(frequency * shelfRatio, (float)rate * .45f);
+    auto boost = juce::Decibels::decibelsToGain(gainDecibels);
+    auto shelfCut = juce::Decibels::decibelsToGain(-gainDecibels * .5f);
+
+    //peaking and shelving biquads with the reciprocal gain are exact inverses of each other
+    pre.setStage(0, Coefficients::makePeakFilter(rate, frequency, peakQ, boost));
+    pre.setStage(1, Coefficients::makeHighShelf(rate, shelfFrequency, juce::MathConstants<float>::sqrt2 * .5f, shelfCut));
+    post.setStage(0, Coefficients::makeHighShelf(rate, shelfFrequency, juce::MathConstants<float>::sqrt2 * .5f, 1 / shelfCut));
+    post.setStage(1, Coefficients::makePeakFilter(rate, frequency, peakQ, 1 / boost));
+}
+
+void EmphasisFilter::processPre(const juce::dsp::AudioBlock<float>& block) noexcept
+{
+    interleaved.interleave(block);
+
+    auto numSamples = interleaved.getNumSamples();
+    numRampSteps = 0;
+
+    if (! gain.isSmoothing() && ! centre.isSmoothing())
+    {
+        pre.process(interleaved, 0, numSamples);
+    }
+    else
+    {
+        //longer steps than usual if the block is bigger than prepared for, ramp never grows here
+        rampStepSize = juce::jmax(rampInterval, (numSamples + (int)ramp.size() - 1) / (int)ramp.size());
+
+        for (int start = 0; start < numSamples; start += rampStepSize)
+        {
+            auto numStepSamples = juce::jmin(rampStepSize, numSamples - start);
+            updateCoefficients(gain.skip(numStepSamples), centre.skip(numStepSamples));
+
+            ramp[(size_t)numRampSteps++] = post.stages;
+            pre.process(interleaved, start, numStepSamples);
+        }
+    }
+
+    interleaved.deinterleave(block);
+}
+
+void EmphasisFilter::processPost(const juce::dsp::AudioBlock<float>& block) noexcept
+{
+    interleaved.interleave(block);
+
+    auto numSamples = interleaved.getNumSamples();
+
+    if (numRampSteps == 0)
+    {
+        post.process(interleaved, 0, numSamples);
+    }
+    else
+    {
+        //the same chunk processPre just had, so the same steps
+        for (int step = 0; step < numRampSteps; ++step)
+        {
+            auto start = step * rampStepSize;
+            post.stages = ramp[(size_t)step];
+            post.process(interleaved, start, juce::jmin(rampStepSize, numSamples - start));
+        }
+    }
+
+    interleaved.deinterleave(block);
+}
+
+//==============================================================================
+void EmphasisFilter::Cascade::setStage(int index, const std::array<float, 6>& coefficients) noexcept
+{
+    auto& stage = stages[(size_t)index];
+    auto a0 = 1 / coefficients[3];
+
+    stage.b0 = Vec::expand(coefficients[0] * a0);
+    stage.b1 = Vec::expand(coefficients[1] * a0);
+    stage.b2 = Vec::expand(coefficients[2] * a0);
+    stage.a1 = Vec::expand(coefficients[4] * a0);
+    stage.a2 = Vec::expand(coefficients[5] * a0);
+}
+
+void EmphasisFilter::Cascade::prepare(int numGroups)
+{
+    states.resize((size_t)numGroups);
+    reset();
+}
+
+void EmphasisFilter::Cascade::reset() noexcept
+{
+    for (auto& groupStates : states)
+        for (auto& state : groupStates)
+            state.s1 = state.s2 = Vec::expand(0);
+}
+
+void EmphasisFilter::Cascade::process(ChannelInterleavedBlock& block, int startSample, int numSamples) noexcept
+{
+    auto numGroups = juce::jmin(block.getNumGroups(), (int)states.size());
+    constexpr auto lanes = ChannelInterleavedBlock::lanes;
+
+    //coefficients and state live in locals for the loop so they stay in registers
+    const auto coefficients = stages;
+
+    for (int group = 0; group < numGroups; ++group)
+    {
+        auto* data = block.getGroup(group) + startSample * lanes;
+        auto local = states[(size_t)group];
+
+        for (int s = 0; s < numSamples; ++s)
+        {
+            auto x = Vec::fromRawArray(data + s * lanes);
+
+            for (int i = 0; i < numStages; ++i)
+            {
+                auto& k = coefficients[(size_t)i];
+                auto& state = local[(size_t)i];
+
+                auto y = k.b0 * x + state.s1;
+                state.s1 = k.b1 * x - k.a1 * y + state.s2;
+                state.s2 = k.b2 * x - k.a2 * y;
+                x = y;
+            }
+
+            x.copyToRawArray(data + s * lanes);
+        }
+
+        states[(size_t)group] = local;
+    }
+}
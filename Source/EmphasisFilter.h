@@ -0,0 +1,82 @@
+/*
+  ==============================================================================
+
+    EmphasisFilter.h
+    Created: 20 Oct 2026 1:06:12am
+    Author:  kylew
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "ChannelInterleavedBlock.h"
+
+//==============================================================================
+/** Pre-emphasis in front of the shaper and the exact inverse behind it, so the distortion
+    leans towards the mids while the clean tonal balance comes back out unchanged.
+
+    Each side is a cascade of biquads in transposed direct form II. The block is transposed
+    into a ChannelInterleavedBlock first, so each group of channels goes through each stage
+    once instead of once per channel, however many channels there are.
+
+    Gain and frequency changes glide over rampSeconds, with fresh coefficients every
+    rampInterval samples. processPost replays the steps processPre took, so both sides
+    stay inverses of each other sample for sample while they move.
+*/
+class EmphasisFilter
+{
+public:
+    using Vec = ChannelInterleavedBlock::Vec;
+    static constexpr int numStages = 2;
+    static constexpr int rampInterval = 32;       //samples between coefficient updates while a parameter moves
+    static constexpr double rampSeconds = .05;
+
+    void prepare(double sampleRate, int maxChannels, int maxBlockSize);
+    void reset() noexcept; //also finishes any glide in progress
+
+    //Sets where gain and frequency glide to. The first call after prepare jumps straight there.
+    //Returns false when the emphasis is flat and not gliding, in which case processing can be
+    //skipped altogether.
+    bool setParameters(float gainDecibels, float frequency) noexcept;
+
+    void processPre(const juce::dsp::AudioBlock<float>& block) noexcept;
+    void processPost(const juce::dsp::AudioBlock<float>& block) noexcept;
+
+private:
+    struct Cascade
+    {
+        struct Stage
+        {
+            Vec b0, b1, b2, a1, a2; //normalized by a0 and broadcast to every lane
+        };
+
+        struct State
+        {
+            Vec s1, s2;
+        };
+
+        std::array<Stage, numStages> stages;
+        std::vector<std::array<State, numStages>> states; //one set per channel group
+
+        void setStage(int index, const std::array<float, 6>& coefficients) noexcept;
+        void prepare(int numGroups);
+        void reset() noexcept;
+        void process(ChannelInterleavedBlock& block, int startSample, int numSamples) noexcept;
+    };
+
+    void updateCoefficients(float gainDecibels, float frequency) noexcept;
+
+    Cascade pre, post;
+    ChannelInterleavedBlock interleaved;
+
+    double rate = 44100;
+    juce::SmoothedValue<float, juce::ValueSmoothingTypes::Linear> gain;                 //dB
+    juce::SmoothedValue<float, juce::ValueSmoothingTypes::Multiplicative> centre;       //Hz, glides evenly in octaves
+    bool primed = false;  //setParameters has been called since prepare
+    bool active = false;  //what setParameters last returned
+
+    std::vector<std::array<Cascade::Stage, numStages>> ramp; //post's coefficients for each step the last processPre took
+    int numRampSteps = 0;
+    int rampStepSize = rampInterval;
+};
@@ -0,0 +1,84 @@
+/*
+  ==============================================================================
+
+    EnvelopeFollower.cpp
+    Created: 20 Oct 2026 1:47:30am
+    Author:  kylew
+
+  ==============================================================================
+*/
+
+#include "EnvelopeFollower.h"
+
+namespace
+{
+    float getCoefficient(float timeMs, double sampleRate)
+    {
+        return 1 - (float)std::exp(-1000.0 / (juce::jmax(.01, (double)timeMs) * sampleRate));
+    }
+}
+
+void EnvelopeFollower::prepare(double sampleRate, int maxChannels, int maxBlockSize)
+{
+    interleaved.prepare(maxChannels, maxBlockSize);
+    states.resize((size_t)((juce::jmax(1, maxChannels) + ChannelInterleavedBlock::lanes - 1) / ChannelInterleavedBlock::lanes));
+
+    rate = sampleRate;
+    currentAttack = currentRelease = -1;
+    reset();
+}
+
+void EnvelopeFollower::reset() noexcept
+{
+    for (auto& state : states)
+        state = Vec::expand(0);
+}
+
+void EnvelopeFollower::setTimes(float attackMs, float releaseMs) noexcept
+{
+    if (attackMs == currentAttack && releaseMs == currentRelease)
+        return;
+
+    currentAttack = attackMs;
+    currentRelease = releaseMs;
+
+    attack = Vec::expand(getCoefficient(attackMs, rate));
+    release = Vec::expand(getCoefficient(releaseMs, rate));
+}
+
+void EnvelopeFollower::process(const juce::dsp::AudioBlock<float>& block, float* envelope) noexcept
+{
+    interleaved.interleave(block);
+
+    auto numGroups = juce::jmin(interleaved.getNumGroups(), (int)states.size());
+    auto numSamples = interleaved.getNumSamples();
+    constexpr auto lanes = ChannelInterleavedBlock::lanes;
+
+    const auto zero = Vec::expand(0);
+    alignas(sizeof(Vec)) std::array<float, lanes> levels{};
+
+    juce::FloatVectorOperations::clear(envelope, numSamples);
+
+    //unused lanes stay at zero, so they never win the max
+    for (int group = 0; group < numGroups; ++group)
+    {
+        auto* data = interleaved.getGroup(group);
+        auto env = states[(size_t)group];
+
+        for (int s = 0; s < numSamples; ++s)
+        {
+            auto difference = Vec::abs(Vec::fromRawArray(data + s * lanes)) - env;
+            env += attack * Vec::max(difference, zero) + release * Vec::min(difference, zero);
+
+            env.copyToRawArray(levels.data());
+
+            auto loudest = envelope[s];
+            for (auto level : levels)
+                loudest = juce::jmax(loudest, level);
+
+            envelope[s] = loudest;
+        }
+
+        states[(size_t)group] = env;
+    }
+}
@@ -0,0 +1,43 @@
+/*
+  ==============================================================================
+
+    EnvelopeFollower.h
+    Created: 20 Oct 2026 1:47:30am
+    Author:  kylew
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "ChannelInterleavedBlock.h"
+
+//==============================================================================
+/** Peak envelope with separate attack and release, linked across channels.
+
+    The input is transposed into a ChannelInterleavedBlock and each channel runs in its own
+    lane. Attack and release are picked per lane without a branch by splitting the difference
+    into its rising and falling parts.
+*/
+class EnvelopeFollower
+{
+public:
+    using Vec = ChannelInterleavedBlock::Vec;
+
+    void prepare(double sampleRate, int maxChannels, int maxBlockSize);
+    void reset() noexcept;
+
+    //Times in milliseconds, only turned into coefficients when they change.
+    void setTimes(float attackMs, float releaseMs) noexcept;
+
+    //Writes the loudest channel's envelope for every sample into envelope.
+    void process(const juce::dsp::AudioBlock<float>& block, float* envelope) noexcept;
+
+private:
+    std::vector<Vec> states; //one per channel group
+    ChannelInterleavedBlock interleaved;
+    Vec attack = Vec::expand(1), release = Vec::expand(1);
+
+    double rate = 44100;
+    float currentAttack = -1, currentRelease = -1;
+};
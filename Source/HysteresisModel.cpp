@@ -0,0 +1,141 @@
+/*
+  ==============================================================================
+
+    HysteresisModel.cpp
+    Created: 20 Oct 2026 12:18:45am
+    Author:  kylew
+
+  ==============================================================================
+*/
+
+#include "HysteresisModel.h"
+
+namespace
+{
+    //Jiles-Atherton constants, normalized to a saturation magnetization of 1
+    constexpr double a = .0625;     //anhysteretic shape
+    constexpr double invA = 1 / a;
+    constexpr double alpha = 1.6e-3; //inter-domain coupling
+    constexpr double c = .17;       //reversible share of the magnetization
+
+    struct Langevin
+    {
+        double value, slope, curvature;
+    };
+
+    //L(q) = coth(q) - 1/q and its first two derivatives. coth comes from the Pade tanh, which is good to
+    //better than 1e-4 up to the clamp, and the series takes over near zero where 1/q cancels.
+    inline Langevin langevin(double q) noexcept
+    {
+        auto small = std::abs(q) < 1.0e-2;
+        auto qs = small ? 1.0 : q;
+        auto invQ = 1 / qs;
+        auto coth = 1 / juce::dsp::FastMathApproximations::tanh(juce::jlimit(-5.0, 5.0, qs));
+        auto csch2 = coth * coth - 1;
+
+        auto q2 = q * q;
+
+        return { small ? q * (1. / 3. - q2 / 45.)       : coth - invQ,
+                 small ? 1. / 3. - q2 / 15.             : invQ * invQ - csch2,
+                 small ? q * (-2. / 15. + q2 * 4. / 189.) : 2 * coth * csch2 - 2 * invQ * invQ * invQ };
+    }
+
+    struct Slope
+    {
+        double value, derivative; //dM/dt and its derivative with respect to M
+    };
+
+    inline Slope getSlope(double m, double h, double hd, double k) noexcept
+    {
+        auto delta = hd >= 0 ? 1.0 : -1.0;
+        auto l = langevin((h + alpha * m) * invA);
+
+        auto mDiff = l.value - m;
+        auto mDiffSlope = l.slope * alpha * invA - 1;
+
+        //irreversible part only while the field moves towards the anhysteretic curve
+        auto kappa = delta * mDiff > 0 ? 1 - c : 0.0;
+        auto denominator = (1 - c) * delta * k - alpha * mDiff;
+
+        auto f1 = kappa * mDiff / denominator;
+        auto f1Slope = kappa * mDiffSlope * (denominator + alpha * mDiff) / (denominator * denominator);
+
+        auto f2 = c * invA * l.slope;
+        auto f2Slope = c * invA * l.curvature * alpha * invA;
+
+        auto f3 = 1 - c * alpha * invA * l.slope;
+        auto f3Slope = -c * alpha * invA * l.curvature * alpha * invA;
+
+        return { hd * (f1 + f2) / f3,
+                 hd * ((f1Slope + f2Slope) * f3 - (f1 + f2) * f3Slope) / (f3 * f3) };
+    }
+}
+
+void HysteresisModel::setSampleRate(double sampleRate) noexcept
+{
+    period = 1 / sampleRate;
+}
+
+void HysteresisModel::reset() noexcept
+{
+    state = {};
+}
+
+void HysteresisModel::setParameters(float drive, float width) noexcept
+{
+    if (drive == currentDrive && width == currentWidth)
+        return;
+
+    currentDrive = drive;
+    currentWidth = width;
+
+    auto q = (double)juce::jmap(drive, .5f, 8.f);
+
+    constants.inputGain = a * q;
+    //the loop has to stay wider than the coupling term or the irreversible slope flips sign
+    constants.k = a * (double)juce::jmap(width, .1f, 1.5f);
+    //full scale input comes out near full scale
+    constants.outputScale = 1 / langevin(q + alpha * invA).value;
+}
+
+void HysteresisModel::process(float* const* channels, int numChannels, int numSamples) noexcept
+{
+    const auto k = constants;
+    const auto halfPeriod = period * .5;
+    const auto rate = 1 / period;
+
+    auto s = state;
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        for (int lane = 0; lane < maxChannels; ++lane)
+        {
+            auto x = lane < numChannels ? (double)channels[lane][i] : 0.0;
+
+            //NaN or garbage input is treated as silence so it can't poison the state
+            auto h = std::abs(x) < 1.0e3 ? x * k.inputGain : 0.0;
+            auto hd = (h - s.h[lane]) * rate;
+
+            auto mPrevious = s.m[lane];
+            auto m = mPrevious + period * s.dmdt[lane];
+
+            for (int iteration = 0; iteration < numIterations; ++iteration)
+            {
+                auto slope = getSlope(m, h, hd, k.k);
+                auto residual = m - mPrevious - halfPeriod * (slope.value + s.dmdt[lane]);
+                auto jacobian = std::fmax(1 - halfPeriod * slope.derivative, .01);
+
+                m = std::fmin(std::fmax(m - residual / jacobian, -1.0), 1.0);
+            }
+
+            s.m[lane] = m;
+            s.h[lane] = h;
+            s.dmdt[lane] = getSlope(m, h, hd, k.k).value;
+
+            if (lane < numChannels)
+                channels[lane][i] = (float)(m * k.outputScale);
+        }
+    }
+
+    state = s;
+}
@@ -0,0 +1,60 @@
+/*
+  ==============================================================================
+
+    HysteresisModel.h
+    Created: 20 Oct 2026 12:18:45am
+    Author:  kylew
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+//==============================================================================
+/** Tape style saturation from the Jiles-Atherton magnetic hysteresis model. Unlike the
+    registry curves it has memory, so the output depends on where the signal came from.
+
+    The ODE is discretized with the trapezoidal rule and the implicit step is solved with a
+    fixed number of Newton-Raphson iterations, starting from the previous sample's slope.
+    Every sample costs the same however badly the solver converges, and the magnetization
+    is clamped to the physical range so a bad step can't run away.
+
+    State is kept as one array per quantity with a lane per channel, and both lanes go
+    through the same arithmetic, so a stereo pair solves together in one SIMD register.
+*/
+class HysteresisModel
+{
+public:
+    static constexpr int maxChannels = 2;
+    static constexpr int numIterations = 4;
+
+    void setSampleRate(double sampleRate) noexcept;
+    void reset() noexcept;
+
+    //Both 0 to 1. Constants are only recomputed when a value actually changes.
+    void setParameters(float drive, float width) noexcept;
+
+    void process(float* const* channels, int numChannels, int numSamples) noexcept;
+
+private:
+    struct Constants
+    {
+        double inputGain = 1;   //H per unit of input
+        double k = .03;         //coercivity, the width of the loop
+        double outputScale = 1;
+    };
+
+    struct State
+    {
+        std::array<double, maxChannels> m{};    //magnetization, normalized so saturation is 1
+        std::array<double, maxChannels> h{};    //last applied field
+        std::array<double, maxChannels> dmdt{}; //last slope, for the trapezoid and the initial guess
+    };
+
+    Constants constants;
+    State state;
+
+    double period = 1. / 44100.;
+    float currentDrive = -1, currentWidth = -1;
+};
@@ -10,35 +10,80 @@
 
 #include "KiTiKLNF.h"
 
-void Laf::drawRotarySlider(juce::Graphics& g, int x, int y, int width, int height, float sliderPos, float rotaryStartAngle, float rotaryEndAngle, juce::Slider& slider)
+namespace
+{
+    //A resize leaves stale entries behind, so the caches are simply dropped once they get this big.
+    constexpr size_t maxCachedGeometry = 16;
+}
+
+const Laf::RotaryGeometry& Laf::getRotaryGeometry(int x, int y, int width, int height, float rotaryStartAngle, float rotaryEndAngle)
 {
     using namespace juce;
 
-    auto unfill = Colour(15u, 15u, 15u);
-    auto fill = Colour(64u, 194u, 230u);
+    auto area = Rectangle<int>(x, y, width, height);
 
-    auto boundsFull = Rectangle<int>(x, y, width, height).toFloat();
-    auto bounds = Rectangle<int>(x, y, width, height).toFloat().reduced(10);
+    for (auto& cached : rotaryCache)
+        if (cached.area == area && cached.startAngle == rotaryStartAngle && cached.endAngle == rotaryEndAngle)
+            return cached;
 
-    auto radius = jmin(bounds.getWidth(), bounds.getHeight()) / 2.0f;
-    auto toAngle = rotaryStartAngle + sliderPos * (rotaryEndAngle - rotaryStartAngle);
-    auto lineW = jmin(8.0f, radius * 0.5f);
-    auto arcRadius = radius - lineW * 0.5f;
+    if (rotaryCache.size() >= maxCachedGeometry)
+        rotaryCache.clear();
+
+    RotaryGeometry geo;
+    geo.area = area;
+    geo.startAngle = rotaryStartAngle;
+    geo.endAngle = rotaryEndAngle;
+
+    geo.boundsFull = area.toFloat();
+    geo.bounds = area.toFloat().reduced(10);
+
+    geo.radius = jmin(geo.bounds.getWidth(), geo.bounds.getHeight()) / 2.0f;
+    geo.lineW = jmin(8.0f, geo.radius * 0.5f);
+    geo.arcRadius = geo.radius - geo.lineW * 0.5f;
 
     auto rootTwo = MathConstants<float>::sqrt2;
 
-    Path backgroundArc;
-    backgroundArc.addCentredArc(bounds.getCentreX(),
-        bounds.getCentreY(),
-        arcRadius,
-        arcRadius,
+    geo.backgroundArc.addCentredArc(geo.bounds.getCentreX(),
+        geo.bounds.getCentreY(),
+        geo.arcRadius,
+        geo.arcRadius,
         0.0f,
         rotaryStartAngle,
         rotaryEndAngle,
         true);
 
+    //make circle with gradient
+    float radialBlur = geo.radius * 2.5;
+
+    geo.gradient = ColourGradient(Colour(186u, 34u, 34u), geo.bounds.getCentreX(), geo.bounds.getCentreY(), Colours::black, radialBlur, radialBlur, true);
+
+    geo.dial.addRoundedRectangle(geo.boundsFull.getCentreX() - (geo.radius * rootTwo / 2), geo.boundsFull.getCentreY() - (geo.radius * rootTwo / 2), geo.radius * rootTwo, geo.radius * rootTwo, geo.radius * .7);
+
+    rotaryCache.push_back(std::move(geo));
+    return rotaryCache.back();
+}
+
+void Laf::drawRotarySlider(juce::Graphics& g, int x, int y, int width, int height, float sliderPos, float rotaryStartAngle, float rotaryEndAngle, juce::Slider& slider)
+{
+    using namespace juce;
+
+    auto unfill = Colour(15u, 15u, 15u);
+    auto fill = Colour(64u, 194u, 230u);
+
+    auto& geo = getRotaryGeometry(x, y, width, height, rotaryStartAngle, rotaryEndAngle);
+
+    auto& boundsFull = geo.boundsFull;
+    auto& bounds = geo.bounds;
+
+    auto radius = geo.radius;
+    auto toAngle = rotaryStartAngle + sliderPos * (rotaryEndAngle - rotaryStartAngle);
+    auto lineW = geo.lineW;
+    auto arcRadius = geo.arcRadius;
+
+    auto rootTwo = MathConstants<float>::sqrt2;
+
     g.setColour(unfill);
-    g.strokePath(backgroundArc, PathStrokeType(lineW / 2, PathStrokeType::curved, PathStrokeType::rounded));
+    g.strokePath(geo.backgroundArc, PathStrokeType(lineW / 2, PathStrokeType::curved, PathStrokeType::rounded));
 
     if (slider.isEnabled())
     {
@@ -56,17 +101,12 @@ void Laf::drawRotarySlider(juce::Graphics& g, int x, int y, int width, int heigh
         g.strokePath(valueArc, PathStrokeType(lineW / 2, PathStrokeType::curved, PathStrokeType::rounded));
     }
 
-    //make circle with gradient
-    float radialBlur = radius * 2.5;
-
-    auto grad = ColourGradient::ColourGradient(Colour(186u, 34u, 34u), bounds.getCentreX(), bounds.getCentreY(), Colours::black, radialBlur, radialBlur, true);
-
-    g.setGradientFill(grad);
-    g.fillRoundedRectangle(boundsFull.getCentreX() - (radius * rootTwo / 2), boundsFull.getCentreY() - (radius * rootTwo / 2), radius * rootTwo, radius * rootTwo, radius * .7);
+    g.setGradientFill(geo.gradient);
+    g.fillPath(geo.dial);
 
     //add circle around dial
     g.setColour(Colours::lightslategrey);
-    g.drawRoundedRectangle(boundsFull.getCentreX() - (radius * rootTwo / 2), boundsFull.getCentreY() - (radius * rootTwo / 2), radius * rootTwo, radius * rootTwo, radius * .7, 1.5f);
+    g.strokePath(geo.dial, PathStrokeType(1.5f));
 
     //make dial line
     g.setColour(Colours::whitesmoke);
@@ -216,10 +256,40 @@ void Laf::drawToggleButton(juce::Graphics& g, juce::ToggleButton& button,
 
 }
 
+const Laf::LinearGeometry& Laf::getLinearGeometry(int x, int y, int width, int height, bool horizontal)
+{
+    using namespace juce;
+
+    auto area = Rectangle<int>(x, y, width, height);
+
+    for (auto& cached : linearCache)
+        if (cached.area == area && cached.horizontal == horizontal)
+            return cached;
+
+    if (linearCache.size() >= maxCachedGeometry)
+        linearCache.clear();
+
+    LinearGeometry geo;
+    geo.area = area;
+    geo.horizontal = horizontal;
+    geo.trackWidth = jmin(6.0f, horizontal ? (float)height * 0.25f : (float)width * 0.25f);
+
+    Point<float> startPoint(horizontal ? (float)x : (float)x + (float)width * 0.5f,
+        horizontal ? (float)y + (float)height * 0.5f : (float)(height + y));
+
+    Point<float> endPoint(horizontal ? (float)(width + x) : startPoint.x,
+        horizontal ? startPoint.y : (float)y);
+
+    geo.backgroundTrack.startNewSubPath(startPoint);
+    geo.backgroundTrack.lineTo(endPoint);
+
+    linearCache.push_back(std::move(geo));
+    return linearCache.back();
+}
+
 void Laf::drawLinearSlider(juce::Graphics& g, int x, int y, int width, int height, float sliderPos, float minSliderPos, float maxSliderPos, const juce::Slider::SliderStyle style, juce::Slider& slider)
 {
     using namespace juce;
-    auto boundsFull = Rectangle<int>(x, y, width, height).toFloat();
 
     if (slider.isBar())
     {
@@ -232,19 +302,14 @@ void Laf::drawLinearSlider(juce::Graphics& g, int x, int y, int width, int heigh
         auto isTwoVal = (style == Slider::SliderStyle::TwoValueVertical || style == Slider::SliderStyle::TwoValueHorizontal);
         auto isThreeVal = (style == Slider::SliderStyle::ThreeValueVertical || style == Slider::SliderStyle::ThreeValueHorizontal);
 
-        auto trackWidth = jmin(6.0f, slider.isHorizontal() ? (float)height * 0.25f : (float)width * 0.25f);
+        auto& geo = getLinearGeometry(x, y, width, height, slider.isHorizontal());
+        auto trackWidth = geo.trackWidth;
 
         Point<float> startPoint(slider.isHorizontal() ? (float)x : (float)x + (float)width * 0.5f,
             slider.isHorizontal() ? (float)y + (float)height * 0.5f : (float)(height + y));
 
-        Point<float> endPoint(slider.isHorizontal() ? (float)(width + x) : startPoint.x,
-            slider.isHorizontal() ? startPoint.y : (float)y);
-
-        Path backgroundTrack;
-        backgroundTrack.startNewSubPath(startPoint);
-        backgroundTrack.lineTo(endPoint);
         g.setColour(Colours::black);
-        g.strokePath(backgroundTrack, { trackWidth, PathStrokeType::curved, PathStrokeType::rounded });
+        g.strokePath(geo.backgroundTrack, { trackWidth, PathStrokeType::curved, PathStrokeType::rounded });
 
         Path valueTrack;
         Point<float> minPoint, maxPoint, thumbPoint;
@@ -420,29 +485,36 @@ void Laf::drawPopupMenuItem(juce::Graphics& g, const juce::Rectangle<int>& area,
     }
 }
 
+void Laf::LevelMeter::resized()
+{
+    using namespace juce;
+
+    //shapes the meters
+    auto bounds = getLocalBounds().toFloat();
+    bounds = bounds.removeFromLeft(bounds.getWidth() * .75);
+    bounds = bounds.removeFromRight(bounds.getWidth() * .66);
+    bounds = bounds.removeFromTop(bounds.getHeight() * .9);
+    bounds = bounds.removeFromBottom(bounds.getHeight() * .88);
+    meterBounds = bounds;
+
+    gradient = ColourGradient(Colours::green, bounds.getBottomLeft(), Colours::red, bounds.getTopLeft(), false);
+    gradient.addColour(.5f, Colours::yellow);
+}
+
 void Laf::LevelMeter::paint(juce::Graphics& g)
 {
     {
         using namespace juce;
 
-        //shapes the meters. May be a bit inefficeint, not sure the best way to move this stuff around, but it is there.
-        auto bounds = getLocalBounds().toFloat();
-        bounds = bounds.removeFromLeft(bounds.getWidth() * .75);
-        bounds = bounds.removeFromRight(bounds.getWidth() * .66);
-        bounds = bounds.removeFromTop(bounds.getHeight() * .9);
-        bounds = bounds.removeFromBottom(bounds.getHeight() * .88);
+        auto bounds = meterBounds;
 
         //get our base rectangle
         g.setColour(Colours::black);
         g.fillRoundedRectangle(bounds, 5.f);
 
-        //get gradient
-        auto gradient = ColourGradient::ColourGradient(Colours::green, bounds.getBottomLeft(), Colours::red, bounds.getTopLeft(), false);
-        gradient.addColour(.5f, Colours::yellow);
-        g.setGradientFill(gradient);
-
         //Show gradient
+        g.setGradientFill(gradient);
         auto levelMeterFill = jmap(level, -60.f, +6.f, 0.f, static_cast<float>(bounds.getHeight()));
         g.fillRoundedRectangle(bounds.removeFromBottom(levelMeterFill), 5.f);
     }
-}
\ No newline at end of file
+}
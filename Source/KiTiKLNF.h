@@ -32,11 +32,46 @@ struct Laf : juce::LookAndFeel_V4 {
     struct LevelMeter : juce::Component
     {
         void paint(juce::Graphics& g) override;
+        void resized() override;
         
         //default value so the meters  are black when the plugin is launched
         void setLevel(float value) { level = value; }
 
     private:
         float level = -60.f;
+
+        //only changes on resize, so it isn't rebuilt every frame
+        juce::Rectangle<float> meterBounds;
+        juce::ColourGradient gradient;
+    };
+
+private:
+    //Everything about a knob that only depends on its size. Looked up by area, so a resize
+    //simply misses the cache and builds a new entry.
+    struct RotaryGeometry
+    {
+        juce::Rectangle<int> area;
+        float startAngle, endAngle;
+
+        juce::Rectangle<float> bounds, boundsFull;
+        float radius, lineW, arcRadius;
+
+        juce::Path backgroundArc, dial;
+        juce::ColourGradient gradient;
     };
+
+    struct LinearGeometry
+    {
+        juce::Rectangle<int> area;
+        bool horizontal;
+
+        float trackWidth;
+        juce::Path backgroundTrack;
+    };
+
+    const RotaryGeometry& getRotaryGeometry(int x, int y, int width, int height, float rotaryStartAngle, float rotaryEndAngle);
+    const LinearGeometry& getLinearGeometry(int x, int y, int width, int height, bool horizontal);
+
+    std::vector<RotaryGeometry> rotaryCache;
+    std::vector<LinearGeometry> linearCache;
 };
\ No newline at end of file
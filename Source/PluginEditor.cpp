@@ -13,8 +13,9 @@
 WaveShaperAudioProcessorEditor::WaveShaperAudioProcessorEditor (WaveShaperAudioProcessor& p)
     : AudioProcessorEditor (&p), audioProcessor (p),
     inGainAT(audioProcessor.apvts, "inGainValue", inGain), outGainAT(audioProcessor.apvts, "outGainValue", outGain),
-    typeSelectAT(audioProcessor.apvts, "typeSelect", typeSelect), bypassAT(audioProcessor.apvts, "bypass", bypass),
-    distortionAT(nullptr)
+    bypassAT(audioProcessor.apvts, "bypass", bypass),
+    typeSelectAT(*audioProcessor.apvts.getParameter("typeSelect"), [this](float value) { classicType = juce::roundToInt(value); updateTypeKnob(); }),
+    curveTypeAT(*audioProcessor.apvts.getParameter("curveType"), [this](float value) { extendedType = juce::roundToInt(value); updateTypeKnob(); })
 {
     setLookAndFeel(&Lnf);
 
@@ -26,16 +27,46 @@ WaveShaperAudioProcessorEditor::WaveShaperAudioProcessorEditor (WaveShaperAudioP
     setRotarySlider(inGain);
     setRotarySlider(outGain);
     setRotarySlider(typeSelect);
-    setRotarySlider(distortion);
     setRotarySlider(bypass);
 
+    for (int curve = 0; curve < CurveRegistry::numCurves; ++curve)
+    {
+        distortion[curve].setName("Shape");
+        setRotarySlider(distortion[curve]);
+        distortion[curve].setVisible(false);
+
+        distortionAT[curve] = std::make_unique<Attachment>(audioProcessor.apvts, CurveRegistry::getCurve(curve).parameterID, distortion[curve]);
+    }
+
+    typeSelect.setRange(1, CurveRegistry::numCurves, 1);
     typeSelect.onValueChange = [this]
         {
-            updateAttachments();
+            auto curve = (int)typeSelect.getValue();
+
+            //the callbacks would put the knob back to a half written state in between
+            settingType = true;
+
+            if (curve <= CurveRegistry::numClassicCurves)
+            {
+                typeSelectAT.setValueAsCompleteGesture((float)curve);
+                curveTypeAT.setValueAsCompleteGesture(0);
+            }
+            else
+            {
+                curveTypeAT.setValueAsCompleteGesture((float)curve);
+            }
+
+            settingType = false;
+            showCurve(curve - 1);
         };
-    
-    updateAttachments();
-    setSize (500, 300);
+
+    typeSelectAT.sendInitialUpdate();
+    curveTypeAT.sendInitialUpdate();
+
+    setResizable(true, true);
+    setResizeLimits(baseWidth / 2, baseHeight / 2, baseWidth * 3, baseHeight * 3);
+    getConstrainer()->setFixedAspectRatio((double)baseWidth / baseHeight);
+    setSize (baseWidth, baseHeight);
     startTimerHz(24);
 }
 
@@ -46,11 +77,31 @@ WaveShaperAudioProcessorEditor::~WaveShaperAudioProcessorEditor()
 
 //==============================================================================
 void WaveShaperAudioProcessorEditor::paint(juce::Graphics& g)
+{
+    //the meters repaint this area every frame, so the artwork is only drawn when the size or display scale changes
+    auto pixelScale = g.getInternalContext().getPhysicalPixelScaleFactor();
+
+    if (background.isNull() || backgroundScale != pixelScale)
+    {
+        background = juce::Image(juce::Image::ARGB, juce::jmax(1, juce::roundToInt(getWidth() * pixelScale)),
+                                 juce::jmax(1, juce::roundToInt(getHeight() * pixelScale)), true);
+
+        juce::Graphics bg(background);
+        bg.addTransform(juce::AffineTransform::scale(pixelScale * getWidth() / baseWidth));
+        drawBackground(bg);
+
+        backgroundScale = pixelScale;
+    }
+
+    g.drawImage(background, getLocalBounds().toFloat());
+}
+
+void WaveShaperAudioProcessorEditor::drawBackground(juce::Graphics& g)
 {
 
     g.fillAll(juce::Colours::black);
-    auto bounds = getLocalBounds();
-    auto logo = juce::ImageCache::getFromMemory(BinaryData::KITIK_LOGO_NO_BKGD_png, BinaryData::KITIK_LOGO_NO_BKGD_pngSize);
+    auto bounds = juce::Rectangle<int>(baseWidth, baseHeight);
+    auto& logo = assets->getLogo();
 
     auto fontSize = 15;
     g.setFont(fontSize);
@@ -78,7 +129,7 @@ void WaveShaperAudioProcessorEditor::paint(juce::Graphics& g)
     name.setY(leftTop.getY() - 10);
     name.setWidth(leftTop.getWidth() / 2);
     name.setHeight(leftTop.getHeight() / 1.3);
-    auto newFont = juce::Font(juce::Typeface::createSystemTypefaceFor(BinaryData::OFFSHORE_TTF, BinaryData::OFFSHORE_TTFSize));
+    auto newFont = juce::Font(assets->getTitleTypeface());
     g.setFont(newFont);
     g.setFont(50);
     g.drawFittedText("KiTiK Wave Shapper", name, juce::Justification::centred, 3);
@@ -111,7 +162,7 @@ void WaveShaperAudioProcessorEditor::paint(juce::Graphics& g)
 
 void WaveShaperAudioProcessorEditor::resized()
 {
-    auto bounds = getLocalBounds();
+    auto bounds = juce::Rectangle<int>(baseWidth, baseHeight);
 
     auto inputMeter = bounds.removeFromLeft(bounds.getWidth() * .05);
     auto meterLSide = inputMeter.removeFromLeft(inputMeter.getWidth() * .5);
@@ -123,7 +174,7 @@ void WaveShaperAudioProcessorEditor::resized()
     outMeter[0].setBounds(outMeterLSide);
     outMeter[1].setBounds(outputMeter);
 
-    bounds = getLocalBounds();
+    bounds = juce::Rectangle<int>(baseWidth, baseHeight);
 
     auto center = bounds.reduced(bounds.getWidth() * .15, bounds.getHeight() * .05);
     auto centerHold = center;
@@ -131,7 +182,8 @@ void WaveShaperAudioProcessorEditor::resized()
     center.removeFromTop(center.getHeight() * .25);
     center.removeFromBottom(center.getHeight() * .33);
 
-    distortion.setBounds(center);
+    for (auto& slider : distortion)
+        slider.setBounds(center);
 
     center = centerHold;
     auto topRow = center.removeFromTop(center.getHeight() * .4);
@@ -145,7 +197,14 @@ void WaveShaperAudioProcessorEditor::resized()
     bypass.setBounds(topRow);
     inGain.setBounds(leftBottom);
     outGain.setBounds(bottomRow);
-    
+
+    //children keep their design-size bounds and get scaled, so JUCE renders them sharp at any size
+    auto scale = juce::AffineTransform::scale((float)getWidth() / baseWidth);
+
+    for (auto* child : getChildren())
+        child->setTransform(scale);
+
+    background = {};
 }
 
 void WaveShaperAudioProcessorEditor::setRotarySlider(juce::Slider& slider)
@@ -156,36 +215,37 @@ void WaveShaperAudioProcessorEditor::setRotarySlider(juce::Slider& slider)
     addAndMakeVisible(slider);
 }
 
-void WaveShaperAudioProcessorEditor::updateAttachments() //Will have to go back and try out a map next time.
+void WaveShaperAudioProcessorEditor::showCurve(int curve)
 {
-    distortionAT.reset();
+    curve = juce::jlimit(0, CurveRegistry::numCurves - 1, curve);
 
-    juce::String newID;
-    auto param = typeSelect.getValue();
+    if (curve == visibleCurve)
+        return;
 
-    if (param == 1)
-    {
-        newID = audioProcessor.apvts.getParameter("sinDistort")->getParameterID();
-    }
-    else if (param == 2)
-    {
-        newID = audioProcessor.apvts.getParameter("quadraticDistort")->getParameterID();
-    }
-    else if (param == 3)
-    {
-        newID = audioProcessor.apvts.getParameter("factorDistort")->getParameterID();
-    }
-    else
-    {
-        newID = audioProcessor.apvts.getParameter("gbDistort")->getParameterID();
-    }
+    if (visibleCurve >= 0)
+        distortion[visibleCurve].setVisible(false);
+
+    distortion[curve].setVisible(true);
+    visibleCurve = curve;
+}
 
-    distortionAT = std::make_unique<Attachment>(audioProcessor.apvts, newID, distortion);
+void WaveShaperAudioProcessorEditor::updateTypeKnob()
+{
+    if (settingType)
+        return;
+
+    auto curve = extendedType > 0 ? extendedType : classicType;
+
+    typeSelect.setValue(curve, juce::dontSendNotification);
+    showCurve(curve - 1);
 }
 
 void WaveShaperAudioProcessorEditor::timerCallback()
 {
-    for (auto channel = 0; channel < audioProcessor.getTotalNumInputChannels(); channel++) {
+    //the meters only have two channels, and the sidechain doesn't count
+    auto numChannels = juce::jmin((int)meter.size(), audioProcessor.getMainBusNumInputChannels());
+
+    for (auto channel = 0; channel < numChannels; channel++) {
         meter[channel].setLevel(audioProcessor.getRMS(channel));
         meter[channel].repaint();
 
@@ -11,6 +11,7 @@
 #include <JuceHeader.h>
 #include "PluginProcessor.h"
 #include "KiTiKLNF.h"
+#include "SharedAssets.h"
 
 //==============================================================================
 /**
@@ -23,14 +24,25 @@ public:
 
     //==============================================================================
     void paint (juce::Graphics&) override;
+    void drawBackground(juce::Graphics&);
     void resized() override;
     void setRotarySlider(juce::Slider&);
-    void updateAttachments();
+    void showCurve(int curve);
+    void updateTypeKnob();
     void timerCallback() override;
 
 private:
 
+    //Everything is laid out at this size and scaled as a whole when the window is resized.
+    static constexpr int baseWidth = 500;
+    static constexpr int baseHeight = 300;
+
     Laf Lnf;
+    juce::SharedResourcePointer<SharedAssets> assets;
+
+    //static artwork, rendered at physical resolution and only redrawn on resize or scale change
+    juce::Image background;
+    float backgroundScale = 0;
 
     WaveShaperAudioProcessor& audioProcessor;
 
@@ -39,14 +51,24 @@ private:
 
     juce::Slider inGain         { "In Gain" },
                  outGain        { "Out Gain" },
-                 typeSelect     { "Type Select" },
-                 distortion     { "Shape" };
+                 typeSelect     { "Type Select" };
+
+    //one drive knob per curve, all attached up front; changing the type only swaps which one is visible
+    std::array<juce::Slider, CurveRegistry::numCurves> distortion;
+    int visibleCurve = -1;
 
     juce::Slider bypass         { "Bypass" };
 
     using Attachment = juce::AudioProcessorValueTreeState::SliderAttachment;
-    Attachment inGainAT, outGainAT, typeSelectAT, bypassAT;
-    std::unique_ptr<Attachment> distortionAT;
+    Attachment inGainAT, outGainAT, bypassAT;
+
+    //typeSelect only covers the classic curves, so the type knob steps through the whole registry and
+    //writes typeSelect or curveType, whichever one selects the curve. The attachments keep their last
+    //values here, so a change doesn't have to look the other parameter up
+    int classicType = 1, extendedType = 0;
+    juce::ParameterAttachment typeSelectAT, curveTypeAT;
+    bool settingType = false;
+    std::array<std::unique_ptr<Attachment>, CurveRegistry::numCurves> distortionAT;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (WaveShaperAudioProcessorEditor)
 };
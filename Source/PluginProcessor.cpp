@@ -9,6 +9,170 @@
 #include "PluginProcessor.h"
 #include "PluginEditor.h"
 
+namespace
+{
+    using Processor = WaveShaperAudioProcessor;
+
+    struct ParameterSpec
+    {
+        enum Type { floatParameter, intParameter, boolParameter, choiceParameter };
+
+        const char* id;
+        const char* name;
+        Type type;
+        float min, max, interval, skew, defaultValue;
+        const char* choices; //'|' separated, choice parameters only
+
+        //stores the parameter in the processor member it belongs to, element picks one out of an array member
+        void (*bind)(Processor& processor, juce::AudioProcessorParameter* parameter, int element);
+    };
+
+    template <typename Parameter> struct ParameterType;
+    template <> struct ParameterType<juce::AudioParameterFloat*>  { static constexpr auto type = ParameterSpec::floatParameter; };
+    template <> struct ParameterType<juce::AudioParameterInt*>    { static constexpr auto type = ParameterSpec::intParameter; };
+    template <> struct ParameterType<juce::AudioParameterBool*>   { static constexpr auto type = ParameterSpec::boolParameter; };
+    template <> struct ParameterType<juce::AudioParameterChoice*> { static constexpr auto type = ParameterSpec::choiceParameter; };
+    template <typename Parameter, size_t size> struct ParameterType<std::array<Parameter, size>> : ParameterType<Parameter> {};
+
+    template <typename Parameter>
+    void assign(Parameter*& target, juce::AudioProcessorParameter* parameter, int)
+    {
+        target = static_cast<Parameter*>(parameter);
+    }
+
+    template <typename Parameter, size_t size>
+    void assign(std::array<Parameter*, size>& target, juce::AudioProcessorParameter* parameter, int element)
+    {
+        target[(size_t)element] = static_cast<Parameter*>(parameter);
+    }
+
+    template <auto member>
+    void bindParameter(Processor& processor, juce::AudioProcessorParameter* parameter, int element)
+    {
+        assign(processor.*member, parameter, element);
+    }
+
+    //The parameter's type comes from the member it's stored in, so the two can't disagree and the
+    //static_cast in assign is always to what makeParameter built.
+    template <auto member>
+    constexpr ParameterSpec makeSpec(const char* id, const char* name, float min, float max, float interval, float skew,
+                                     float defaultValue, const char* choices = nullptr)
+    {
+        using Member = std::remove_reference_t<decltype(std::declval<Processor&>().*member)>;
+        return { id, name, ParameterType<Member>::type, min, max, interval, skew, defaultValue, choices, &bindParameter<member> };
+    }
+
+    constexpr float numCurves = (float)CurveRegistry::numCurves;
+
+    std::unique_ptr<juce::RangedAudioParameter> makeParameter(const ParameterSpec& spec, const juce::String& id, const juce::String& name)
+    {
+        using namespace juce;
+
+        switch (spec.type)
+        {
+            case ParameterSpec::intParameter:
+                return std::make_unique<AudioParameterInt>(id, name, (int)spec.min, (int)spec.max, (int)spec.defaultValue);
+            case ParameterSpec::boolParameter:
+                return std::make_unique<AudioParameterBool>(id, name, spec.defaultValue != 0);
+            case ParameterSpec::choiceParameter:
+                return std::make_unique<AudioParameterChoice>(id, name, StringArray::fromTokens(spec.choices, "|", {}), (int)spec.defaultValue);
+            case ParameterSpec::floatParameter:
+            default:
+                return std::make_unique<AudioParameterFloat>(id, name, NormalisableRange<float>(spec.min, spec.max, spec.interval, spec.skew), spec.defaultValue);
+        }
+    }
+}
+
+//Every parameter, the member it lives in, and the one walk that puts them in layout order. Both
+//createParameterLayout and the constructor go through forEach, so the pointers can't drift from the layout.
+struct WaveShaperParameters
+{
+    //The original layout, which hosts have sessions and automation for. Its IDs, ranges and positions
+    //never change: in gain and type, then the classic curves' drives, then out gain and bypass.
+    static constexpr ParameterSpec headParameters[]
+    {
+        makeSpec<&Processor::inGainValue>("inGainValue", "Gain In", -20, 20, .1f, 1, 0),
+        makeSpec<&Processor::typeSelect>("typeSelect", "Disrotion Type", 1, (float)CurveRegistry::numClassicCurves, 1, 1, 1)
+    };
+
+    static constexpr ParameterSpec originalTailParameters[]
+    {
+        makeSpec<&Processor::outGainValue>("outGainValue", "Gain Out", -20, 20, .1f, 1, 0),
+        makeSpec<&Processor::bypass>("bypass", "Bypassed", 0, 1, 1, 1, 0)
+    };
+
+    //Everything added since. Only ever append.
+    static constexpr ParameterSpec appendedParameters[]
+    {
+        makeSpec<&Processor::quality>("quality", "Oversampling", 0, 4, 1, 1, 1, "Auto|1x|2x|4x|8x"), //1x, Auto adds latency
+        makeSpec<&Processor::curveType>("curveType", "Curve Type", 0, numCurves, 1, 1, 0), //0 follows typeSelect
+        makeSpec<&Processor::morphTarget>("morphTarget", "Morph Type", 1, numCurves, 1, 1, 2),
+        makeSpec<&Processor::morphAmount>("morphAmount", "Morph", 0, 1, .01f, 1, 0),
+        makeSpec<&Processor::autoGain>("autoGain", "Auto Gain", 0, 1, 1, 1, 0),
+        makeSpec<&Processor::model>("model", "Saturation Model", 0, 1, 1, 1, 0, "Curve|Hysteresis"),
+        makeSpec<&Processor::hysteresisDrive>("hysteresisDrive", "Hysteresis Drive", 0, 1, .01f, 1, .5f),
+        makeSpec<&Processor::hysteresisWidth>("hysteresisWidth", "Hysteresis Width", 0, 1, .01f, 1, .5f),
+        makeSpec<&Processor::emphasisGain>("emphasisGain", "Emphasis", 0, 18, .1f, 1, 0),
+        makeSpec<&Processor::emphasisFrequency>("emphasisFrequency", "Emphasis Frequency", 200, 5000, 1, .3f, 1000),
+        makeSpec<&Processor::cascadeStages>("cascadeStages", "Stages", 1, Processor::maxCascadeStages, 1, 1, 1),
+        makeSpec<&Processor::stereoMode>("stereoMode", "Stereo Mode", 0, 1, 1, 1, 0, "Stereo|Mid/Side"),
+        makeSpec<&Processor::sideCurve>("sideCurve", "Side Type", 1, numCurves, 1, 1, 1),
+        makeSpec<&Processor::sideDrive>("sideDrive", "Side Drive", 0, 1, .01f, 1, .5f),
+        makeSpec<&Processor::dynamicDepth>("dynamicDepth", "Dynamic Drive", -1, 1, .01f, 1, 0),
+        makeSpec<&Processor::dynamicAttack>("dynamicAttack", "Dynamic Attack", .1f, 100, .1f, .4f, 5),
+        makeSpec<&Processor::dynamicRelease>("dynamicRelease", "Dynamic Release", 5, 1000, 1, .4f, 100),
+        makeSpec<&Processor::dynamicSource>("dynamicSource", "Dynamic Source", 0, 1, 1, 1, 0, "Input|Sidechain")
+    };
+
+    //repeated for cascade stages 2 and up, IDs and names get the stage prefixed
+    static constexpr ParameterSpec stageParameters[]
+    {
+        makeSpec<&Processor::stageCurves>("Curve", " Type", 1, numCurves, 1, 1, 1),
+        makeSpec<&Processor::stageDrives>("Drive", " Drive", 0, 1, .01f, 1, .5f),
+        makeSpec<&Processor::stageGains>("Gain", " Gain", -20, 20, .1f, 1, 0)
+    };
+
+    //Hosts that automate by index depend on this order. The original eight parameters come first and
+    //never move. The drives of curves past the classic four go last, so a curve added to the registry
+    //only appends; a new parameter of any other kind goes after them.
+    //visit(spec, id, name, element) is called once per parameter, in layout order.
+    template <typename Visitor>
+    static void forEach(Visitor&& visit)
+    {
+        using juce::String;
+
+        auto visitDrive = [&visit](int curve)
+        {
+            auto& descriptor = CurveRegistry::getCurve(curve);
+            auto spec = makeSpec<&Processor::drives>(descriptor.parameterID, descriptor.name, descriptor.minDrive, descriptor.maxDrive,
+                                                     descriptor.interval, 1, descriptor.defaultDrive);
+            visit(spec, String(descriptor.parameterID), String(descriptor.name) + " Distortion Factor", curve);
+        };
+
+        for (auto& spec : headParameters)
+            visit(spec, String(spec.id), String(spec.name), 0);
+
+        for (int curve = 0; curve < CurveRegistry::numClassicCurves; ++curve)
+            visitDrive(curve);
+
+        for (auto& spec : originalTailParameters)
+            visit(spec, String(spec.id), String(spec.name), 0);
+
+        for (auto& spec : appendedParameters)
+            visit(spec, String(spec.id), String(spec.name), 0);
+
+        //the stages sit in the middle of the layout, another one would move every drive after them
+        static_assert(Processor::maxCascadeStages == 4, "append new stages' parameters at the end instead");
+
+        for (int stage = 2; stage <= Processor::maxCascadeStages; ++stage)
+            for (auto& spec : stageParameters)
+                visit(spec, "stage" + String(stage) + spec.id, "Stage " + String(stage) + spec.name, stage - 2);
+
+        for (int curve = CurveRegistry::numClassicCurves; curve < CurveRegistry::numCurves; ++curve)
+            visitDrive(curve);
+    }
+};
+
 //==============================================================================
 WaveShaperAudioProcessor::WaveShaperAudioProcessor()
 #ifndef JucePlugin_PreferredChannelConfigurations
@@ -16,21 +180,38 @@ WaveShaperAudioProcessor::WaveShaperAudioProcessor()
                      #if ! JucePlugin_IsMidiEffect
                       #if ! JucePlugin_IsSynth
                        .withInput  ("Input",  juce::AudioChannelSet::stereo(), true)
+                       .withInput  ("Sidechain", juce::AudioChannelSet::stereo(), false)
                       #endif
                        .withOutput ("Output", juce::AudioChannelSet::stereo(), true)
                      #endif
                        )
 #endif
 {
-    bypass = dynamic_cast<juce::AudioParameterBool*>(apvts.getParameter("bypass"));
-    typeSelect = dynamic_cast<juce::AudioParameterInt*>(apvts.getParameter("typeSelect"));
-    sinDistort = dynamic_cast<juce::AudioParameterFloat*>(apvts.getParameter("sinDistort"));
-    quadraticDistort = dynamic_cast<juce::AudioParameterFloat*>(apvts.getParameter("quadraticDistort"));
-    factorDistort = dynamic_cast<juce::AudioParameterFloat*>(apvts.getParameter("factorDistort"));
-    gbDistort = dynamic_cast<juce::AudioParameterFloat*>(apvts.getParameter("gbDistort"));
-    inGainValue = dynamic_cast<juce::AudioParameterFloat*>(apvts.getParameter("inGainValue"));
-    outGainValue = dynamic_cast<juce::AudioParameterFloat*>(apvts.getParameter("outGainValue"));
+    //getParameters() is in layout order, so every pointer is picked out by position instead of a string
+    //lookup each. The ID check runs in every build, it's one compare per parameter: if the layout and the
+    //walk ever disagree, the parameter is found by ID instead of being cast to whatever type sits there.
+    auto& parameters = getParameters();
+    auto index = 0;
+
+    WaveShaperParameters::forEach([&](const ParameterSpec& spec, const juce::String& id, const juce::String&, int element)
+    {
+        auto* parameter = parameters[index++];
+        auto* withID = dynamic_cast<juce::AudioProcessorParameterWithID*>(parameter);
+
+        if (withID == nullptr || withID->paramID != id)
+        {
+            jassertfalse; //createParameterLayout didn't go through forEach
+            parameter = apvts.getParameter(id);
+        }
+
+        spec.bind(*this, parameter, element);
+    });
+
+    jassert(index == parameters.size());
 
+    //auto gain reads the input level on the very first block, so it has to start out as silence
+    for (int channel = 0; channel < 2; ++channel)
+        rmsIn[channel] = rmsOut[channel] = -60;
 }
 
 WaveShaperAudioProcessor::~WaveShaperAudioProcessor()
@@ -104,7 +285,7 @@ void WaveShaperAudioProcessor::prepareToPlay (double sampleRate, int samplesPerB
 {
     juce::dsp::ProcessSpec spec;
     spec.maximumBlockSize = samplesPerBlock;
-    spec.numChannels = getTotalNumInputChannels();
+    spec.numChannels = getMainBusNumInputChannels();
     spec.sampleRate = sampleRate;
 
     inGain.reset();
@@ -112,6 +293,55 @@ void WaveShaperAudioProcessor::prepareToPlay (double sampleRate, int samplesPerB
 
     outGain.reset();
     outGain.prepare(spec);
+    outGain.setRampDurationSeconds(.05); //auto gain moves it every block
+
+    //the chunk loop never hands the oversamplers, the filters or the dry buffer more than this, however big the host's blocks get
+    preparedBlockSize = juce::jmax(1, samplesPerBlock);
+    dryBuffer.setSize(spec.numChannels, preparedBlockSize);
+    orderFadeBuffer.setSize(spec.numChannels, preparedBlockSize);
+
+    emphasis.prepare(sampleRate, spec.numChannels, preparedBlockSize);
+    envelopeFollower.prepare(sampleRate, getTotalNumInputChannels(), preparedBlockSize); //may listen to the sidechain
+
+    //chunks never exceed maxChunkSize, and the drive buffer runs at the oversampled rate
+    envelope.resize(maxChunkSize);
+    driveBuffer.resize(maxChunkSize << maxOversamplingOrder);
+
+    bypassFade.reset(sampleRate, .005);
+    bypassFade.setCurrentAndTargetValue(bypass->get() ? 1.f : 0.f);
+
+    morph.reset(sampleRate, .05);
+    morph.setCurrentAndTargetValue(morphAmount->get());
+
+    auto maxLatency = 0;
+
+    for (int order = 1; order <= maxOversamplingOrder; ++order)
+    {
+        oversamplers[order] = std::make_unique<juce::dsp::Oversampling<float>>(spec.numChannels, order,
+            juce::dsp::Oversampling<float>::filterHalfBandPolyphaseIIR, true, true);
+        oversamplers[order]->initProcessing(spec.maximumBlockSize);
+        maxLatency = juce::jmax(maxLatency, juce::roundToInt(oversamplers[order]->getLatencyInSamples()));
+    }
+
+    dryDelay.prepare(spec);
+    dryDelay.setMaximumDelayInSamples(maxLatency + 1);
+
+    for (auto& pad : latencyPads)
+    {
+        pad.prepare(spec);
+        pad.setMaximumDelayInSamples(maxLatency + 1);
+    }
+
+    orderFade.reset(sampleRate, orderFadeSeconds);
+    orderFade.setCurrentAndTargetValue(1);
+
+    for (int channel = 0; channel < 2; ++channel)
+        rmsIn[channel] = rmsOut[channel] = -60;
+
+    cpuLoad = 0;
+    samplesSinceSwitch = 0;
+    latencyQuality = -1;
+    setOversamplingOrder(chooseOversamplingOrder(), false);
 }
 
 void WaveShaperAudioProcessor::releaseResources()
@@ -139,6 +369,11 @@ bool WaveShaperAudioProcessor::isBusesLayoutSupported (const BusesLayout& layout
    #if ! JucePlugin_IsSynth
     if (layouts.getMainOutputChannelSet() != layouts.getMainInputChannelSet())
         return false;
+
+    // The sidechain is optional, and mono or stereo when it's there
+    auto sidechain = layouts.getChannelSet(true, 1);
+    if (! sidechain.isDisabled() && sidechain != juce::AudioChannelSet::mono() && sidechain != juce::AudioChannelSet::stereo())
+        return false;
    #endif
 
     return true;
@@ -149,121 +384,620 @@ bool WaveShaperAudioProcessor::isBusesLayoutSupported (const BusesLayout& layout
 void WaveShaperAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages)
 {
     juce::ScopedNoDenormals noDenormals;
-    auto totalNumInputChannels  = getTotalNumInputChannels();
+    WAVESHAPER_TRACE_ZONE("processBlock");
+    auto blockStart = juce::Time::getHighResolutionTicks();
+    auto mainBuffer = getBusBuffer(buffer, true, 0);
+    auto sidechainBuffer = getBusBuffer(buffer, true, 1);
+    auto totalNumInputChannels  = mainBuffer.getNumChannels(); //the sidechain is only listened to
     auto totalNumOutputChannels = getTotalNumOutputChannels();
-
-    for (auto channel = 0; channel < totalNumInputChannels; channel++) {
-        rmsIn[channel] = juce::Decibels::gainToDecibels(buffer.getRMSLevel(channel, 0, buffer.getNumSamples()));
-        if (rmsIn[channel] < -60) { rmsIn[channel] = -60; }
-    }
+    auto numSamples = buffer.getNumSamples();
 
     for (auto i = totalNumInputChannels; i < totalNumOutputChannels; ++i)
-        buffer.clear (i, 0, buffer.getNumSamples());
+        buffer.clear (i, 0, numSamples);
 
-    if (bypass->get())
+    if (numSamples == 0)
         return;
 
-    auto block = juce::dsp::AudioBlock<float>(buffer);
-    auto context = juce::dsp::ProcessContextReplacing<float>(block);
+    bypassFade.setTargetValue(bypass->get() || hostBypassed ? 1.f : 0.f);
 
-    inGain.setGainDecibels(inGainValue->get());
-    inGain.process(context);
-
-    for (int channel = 0; channel < totalNumInputChannels; ++channel)
+    //fully bypassed: the input only goes through the latency delay, nothing is processed or metered.
+    //Garbage still becomes silence, the delay is what the crossfade reads once bypass is lifted.
+    if (! bypassFade.isSmoothing() && bypassFade.getTargetValue() == 1.f)
     {
-        switch (typeSelect->get())
+        auto ignored = 0;
+
+        for (auto channel = 0; channel < totalNumInputChannels; channel++)
+            sanitize(mainBuffer.getWritePointer(channel), numSamples, ignored);
+
+        if (getLatencySamples() > 0)
         {
-            case WaveShaper::sinusoidal:
-                processSinusoidal(channel, buffer);
-                break;
-            
-            case WaveShaper::quadratic:
-                processQuadratic(channel, buffer);
-                break;
-            
-            case WaveShaper::factor:
-                processFactor(channel, buffer);
-                break;
-
-            case WaveShaper::GloubiBoulga:
-                processGB(channel, buffer);
-                break;
+            auto dry = juce::dsp::AudioBlock<float>(mainBuffer);
+            dryDelay.process(juce::dsp::ProcessContextReplacing<float>(dry));
         }
 
-        //else if (typeSelect->get() == 4) //this would be more useful in an on off scenario, like synth
-        //{
-        //    for (int s = 0; s < buffer.getNumSamples(); ++s) 
-        //    {
-        //        channelData[s] = 1.5 * channelData[s] - .5 * pow(channelData[s], 3);
-        //    }
-        //}
+        for (auto channel = 0; channel < totalNumInputChannels; channel++)
+            rmsIn[channel] = rmsOut[channel] = -60;
+
+        fullyBypassed = true;
+        return;
     }
 
-    outGain.setGainDecibels(outGainValue->get());
-    outGain.process(context);
+    //coming out of bypass: the processing state still holds audio from before it, start from silence
+    if (fullyBypassed)
+    {
+        resetProcessingState();
+        fullyBypassed = false;
+    }
 
-    for (auto channel = 0; channel < totalNumInputChannels; channel++) {
-        rmsOut[channel] = juce::Decibels::gainToDecibels(buffer.getRMSLevel(channel, 0, buffer.getNumSamples()));
-        if (rmsOut[channel] < -60) { rmsOut[channel] = -60; }
+    auto block = juce::dsp::AudioBlock<float>(mainBuffer);
+
+    inGain.setGainDecibels(inGainValue->get());
+
+    auto curve = getSelectedCurve();
+    auto& descriptor = CurveRegistry::getCurve(curve);
+    auto drive = getDrive(curve);
+    auto coefficients = descriptor.prepare(drive);
+
+    const CurveTable* table = nullptr;
+
+   #if WAVESHAPER_CURVE_TABLES
+    curveTables.startBlock();
+
+    if (descriptor.tableRange > 0)
+    {
+        auto tableKey = CurveTableCache::makeKey(curve, drive);
+        curveTables.request(tableKey);
+        table = curveTables.getTable(tableKey);
     }
-}
+   #endif
 
-void WaveShaperAudioProcessor::processSinusoidal(int channel, juce::AudioBuffer<float>& buffer)
-{
-    float* data = buffer.getWritePointer(channel);
+    auto morphCurve = morphTarget->get() - 1;
+    auto morphCoefficients = CurveRegistry::getCurve(morphCurve).prepare(getDrive(morphCurve));
+    auto morphFunction = CurveRegistry::getMorphFunction(curve, morphCurve);
+
+    morph.setTargetValue(morphAmount->get());
+    auto morphing = morph.isSmoothing() || morph.getTargetValue() > 0;
+
+    auto order = chooseOversamplingOrder();
+    if (order != oversamplingOrder)
+        setOversamplingOrder(order, true);
+    else if (quality->getIndex() != latencyQuality)
+        updateLatency(); //e.g. Auto to the order it was already running, which still changes the latency
+
+    auto emphasising = emphasis.setParameters(emphasisGain->get(), emphasisFrequency->get());
+
+    auto useHysteresis = model->getIndex() == Model::hysteresisModel;
+    if (useHysteresis)
+    {
+        hysteresis.setSampleRate(getSampleRate() * (1 << order));
+        hysteresis.setParameters(hysteresisDrive->get(), hysteresisWidth->get());
+        fadingHysteresis.setParameters(hysteresisDrive->get(), hysteresisWidth->get());
+    }
 
-    auto z = juce::MathConstants<float>::pi * sinDistort->get();
-    auto a = (1 / sin(z));
-    auto b = 1 / sinDistort->get();
 
-    for (int s = 0; s < buffer.getNumSamples(); ++s)
+    //mid/side shapes mid with the main curve and side with its own, on the plain curve path
+    auto midSide = stereoMode->getIndex() == StereoMode::midSideStereo && totalNumInputChannels == 2 && ! useHysteresis && ! morphing;
+    auto& sideDescriptor = CurveRegistry::getCurve(sideCurve->get() - 1);
+    auto sideCoefficients = sideDescriptor.prepare(juce::jmap(sideDrive->get(), sideDescriptor.minDrive, sideDescriptor.maxDrive));
+    auto midSideFunction = CurveRegistry::getMidSideFunction(curve, sideCurve->get() - 1);
+
+    //dynamic drive moves the main curve only, on the plain curve path
+    auto dynamic = dynamicDepth->get() != 0 && ! useHysteresis && ! morphing && ! midSide;
+    auto driveDepth = (descriptor.maxDrive - descriptor.minDrive) * dynamicDepth->get();
+    auto& envelopeSource = dynamicSource->getIndex() == 1 && sidechainBuffer.getNumChannels() > 0 ? sidechainBuffer : mainBuffer;
+
+    if (dynamic)
+        envelopeFollower.setTimes(dynamicAttack->get(), dynamicRelease->get());
+
+    //with more than one stage, the plain curve path folds its shaping into the cascade; morph and hysteresis
+    //keep their own pass and the cascade picks up after them
+    std::array<CascadeStage, maxCascadeStages> cascade;
+    auto cascading = cascadeStages->get() > 1;
+    auto numCascadeStages = cascading ? prepareCascade(cascade, { &descriptor, coefficients, 1.f }, ! (useHysteresis || morphing || midSide || dynamic)) : 0;
+
+    auto shaperMode = useHysteresis ? ShaperMode::hysteresisShaper : morphing ? ShaperMode::morphShaper : midSide ? ShaperMode::midSideShaper
+                    : dynamic ? ShaperMode::dynamicShaper : ShaperMode::plainShaper;
+    auto makeup = autoGain->get() ? getAutoGain(curve, shaperMode, morph.getTargetValue(), cascade.data(), numCascadeStages) : 0.f;
+    outGain.setGainDecibels(outGainValue->get() + makeup);
+
+    //the dry signal is needed for a crossfade, and the delay has to keep hearing it while there's latency
+    //so a future crossfade starts with the right history
+    auto fading = bypassFade.isSmoothing();
+    auto needDry = fading || getLatencySamples() > 0;
+
+    std::array<float, 2> inSquares{}, outSquares{};
+    std::array<int, 2> inClips{}, outClips{};
+    auto crossSum = 0.f, envelopeSum = 0.f; //for next block's auto gain
+
+    //Up, shape, down and pad to the reported latency, at one order. Everything it touches besides the
+    //hysteresis model and the oversampler and pad of that order is stateless, so while the order changes
+    //the outgoing order can run on a copy of the chunk next to the new one.
+    auto shapeChunk = [&](juce::dsp::AudioBlock<float> chunk, int shapeOrder, HysteresisModel& model, float morphStart, float morphEnd)
+    {
+        auto shapeBlock = chunk;
+
+        if (shapeOrder > 0)
+        {
+            WAVESHAPER_TRACE_ZONE("oversample up");
+            shapeBlock = oversamplers[shapeOrder]->processSamplesUp(chunk);
+        }
+
+        auto numShapeSamples = (int)shapeBlock.getNumSamples();
+
+        {
+            WAVESHAPER_TRACE_ZONE(useHysteresis ? "processHysteresis" : morphing ? "processMorph" : midSide ? "processMidSide"
+                                  : dynamic ? "processModulated" : cascading ? "processCascade" : "processCurve");
+
+            if (useHysteresis)
+            {
+                std::array<float*, HysteresisModel::maxChannels> channels{};
+                auto numChannels = juce::jmin(totalNumInputChannels, HysteresisModel::maxChannels);
+
+                for (int channel = 0; channel < numChannels; ++channel)
+                    channels[channel] = shapeBlock.getChannelPointer(channel);
+
+                model.process(channels.data(), numChannels, numShapeSamples);
+            }
+            else if (morphing)
+            {
+                auto morphStep = (morphEnd - morphStart) / numShapeSamples;
+
+                for (int channel = 0; channel < totalNumInputChannels; ++channel)
+                    morphFunction(shapeBlock.getChannelPointer(channel), numShapeSamples, coefficients, morphCoefficients, morphStart, morphStep);
+            }
+            else if (midSide)
+            {
+                midSideFunction(shapeBlock.getChannelPointer(0), shapeBlock.getChannelPointer(1), numShapeSamples, coefficients, sideCoefficients);
+            }
+            else if (dynamic)
+            {
+                //one drive value per oversampled sample, held across each base rate envelope sample
+                for (int s = 0; s < numShapeSamples; ++s)
+                    driveBuffer[s] = juce::jlimit(descriptor.minDrive, descriptor.maxDrive, drive + driveDepth * envelope[s >> shapeOrder]);
+
+                for (int channel = 0; channel < totalNumInputChannels; ++channel)
+                    descriptor.processModulated(shapeBlock.getChannelPointer(channel), numShapeSamples, driveBuffer.data());
+            }
+            else if (! cascading)
+            {
+                for (int channel = 0; channel < totalNumInputChannels; ++channel)
+                    shapeChannel(shapeBlock.getChannelPointer(channel), numShapeSamples, descriptor, coefficients, table);
+            }
+
+            if (cascading)
+            {
+                for (int channel = 0; channel < totalNumInputChannels; ++channel)
+                    CurveRegistry::processCascade(shapeBlock.getChannelPointer(channel), numShapeSamples, cascade.data(), numCascadeStages);
+            }
+        }
+
+        if (shapeOrder > 0)
+        {
+            WAVESHAPER_TRACE_ZONE("oversample down");
+            oversamplers[shapeOrder]->processSamplesDown(chunk);
+        }
+
+        if (padSamples[shapeOrder] > 0)
+            latencyPads[shapeOrder].process(juce::dsp::ProcessContextReplacing<float>(chunk));
+    };
+
+    //Run the whole chain on one small chunk at a time, so each stage finds the previous stage's output still in L1
+    //instead of every stage streaming the full host buffer through the cache.
+    auto chunkSize = juce::jmin(processingChunkSize.load(std::memory_order_relaxed), preparedBlockSize);
+
+    for (int start = 0; start < numSamples; start += chunkSize)
     {
-        if (data[s] > b)
+        auto chunk = block.getSubBlock((size_t)start, (size_t)juce::jmin(chunkSize, numSamples - start));
+        auto numChunkSamples = (int)chunk.getNumSamples();
+        auto context = juce::dsp::ProcessContextReplacing<float>(chunk);
+
+        {
+            WAVESHAPER_TRACE_ZONE("input metering");
+
+            for (auto channel = 0; channel < totalNumInputChannels; channel++)
+                inSquares[channel] += sanitize(chunk.getChannelPointer(channel), numChunkSamples, inClips[channel]);
+
+            if (midSide)
+                for (int s = 0; s < numChunkSamples; ++s)
+                    crossSum += chunk.getSample(0, s) * chunk.getSample(1, s);
+        }
+
+        if (needDry)
         {
-            data[s] = 1;
+            auto dry = juce::dsp::AudioBlock<float>(dryBuffer).getSubsetChannelBlock(0, (size_t)totalNumInputChannels)
+                                                              .getSubBlock(0, (size_t)numChunkSamples);
+            dry.copyFrom(chunk);
+            dryDelay.process(juce::dsp::ProcessContextReplacing<float>(dry));
+        }
+
+        {
+            WAVESHAPER_TRACE_ZONE("inGain");
+            inGain.process(context);
+        }
+
+        if (dynamic)
+        {
+            WAVESHAPER_TRACE_ZONE("envelope");
+            auto source = juce::dsp::AudioBlock<float>(envelopeSource).getSubBlock((size_t)start, (size_t)numChunkSamples);
+
+            //the main input is already clean, the sidechain isn't, and one NaN would stick in the envelope
+            if (&envelopeSource == &sidechainBuffer)
+            {
+                auto ignored = 0;
+
+                for (size_t channel = 0; channel < source.getNumChannels(); ++channel)
+                    sanitize(source.getChannelPointer(channel), numChunkSamples, ignored);
+            }
+
+            envelopeFollower.process(source, envelope.data());
+
+            for (int s = 0; s < numChunkSamples; ++s)
+                envelopeSum += envelope[s];
+        }
+
+        if (emphasising)
+        {
+            WAVESHAPER_TRACE_ZONE("emphasis pre");
+            emphasis.processPre(chunk);
+        }
+
+        //the smoother is linear, so each chunk's ramp is fully described by its start and end
+        auto morphStart = morph.getCurrentValue();
+        auto morphEnd = morphing ? morph.skip(numChunkSamples) : morphStart;
+
+        if (orderFade.isSmoothing())
+        {
+            auto outgoing = juce::dsp::AudioBlock<float>(orderFadeBuffer).getSubsetChannelBlock(0, (size_t)totalNumInputChannels)
+                                                                        .getSubBlock(0, (size_t)numChunkSamples);
+            outgoing.copyFrom(chunk);
+
+            shapeChunk(outgoing, fadingFromOrder, fadingHysteresis, morphStart, morphEnd);
+            shapeChunk(chunk, order, hysteresis, morphStart, morphEnd);
+
+            WAVESHAPER_TRACE_ZONE("order crossfade");
+
+            for (int s = 0; s < numChunkSamples; ++s)
+            {
+                auto newAmount = orderFade.getNextValue();
+
+                for (int channel = 0; channel < totalNumInputChannels; ++channel)
+                {
+                    auto* wet = chunk.getChannelPointer(channel);
+                    wet[s] = outgoing.getSample(channel, s) + newAmount * (wet[s] - outgoing.getSample(channel, s));
+                }
+            }
         }
         else
         {
-            data[s] = sin(z * data[s]) * a;
+            shapeChunk(chunk, order, hysteresis, morphStart, morphEnd);
+        }
+
+        if (emphasising)
+        {
+            WAVESHAPER_TRACE_ZONE("emphasis post");
+            emphasis.processPost(chunk);
+        }
+
+        {
+            WAVESHAPER_TRACE_ZONE("outGain");
+            outGain.process(context);
+        }
+
+        {
+            WAVESHAPER_TRACE_ZONE("output metering");
+
+            for (auto channel = 0; channel < totalNumInputChannels; channel++)
+                outSquares[channel] += sumOfSquares(chunk.getChannelPointer(channel), numChunkSamples, outClips[channel]);
+        }
+
+        if (fading)
+        {
+            for (int s = 0; s < numChunkSamples; ++s)
+            {
+                auto dryAmount = bypassFade.getNextValue();
+
+                for (int channel = 0; channel < totalNumInputChannels; ++channel)
+                {
+                    auto* wet = chunk.getChannelPointer(channel);
+                    wet[s] += dryAmount * (dryBuffer.getSample(channel, s) - wet[s]);
+                }
+            }
         }
+    }
+
+    for (auto channel = 0; channel < totalNumInputChannels; channel++) {
+        rmsIn[channel] = juce::Decibels::gainToDecibels(std::sqrt(inSquares[channel] / numSamples));
+        if (rmsIn[channel] < -60) { rmsIn[channel] = -60; }
+
+        rmsOut[channel] = juce::Decibels::gainToDecibels(std::sqrt(outSquares[channel] / numSamples));
+        if (rmsOut[channel] < -60) { rmsOut[channel] = -60; }
+
+        telemetry.setLevels(channel, rmsIn[channel], rmsOut[channel], inClips[channel], outClips[channel]);
+    }
+
+    //mid and side power from the channel powers and their correlation, (L + R) / 2 and (L - R) / 2
+    if (midSide)
+    {
+        auto channelPower = (inSquares[0] + inSquares[1]) / numSamples;
+        auto cross = 2 * crossSum / numSamples;
+        midSidePower = { juce::jmax(0.f, channelPower + cross) * .25f, juce::jmax(0.f, channelPower - cross) * .25f };
+    }
+
+    if (dynamic)
+        envelopeMean = envelopeSum / numSamples;
+
+    auto blockSeconds = juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - blockStart);
+    updateAutoQuality(blockSeconds, numSamples);
+
+    telemetry.setCurve(useHysteresis ? CurveRegistry::numCurves : curve, useHysteresis ? "Hysteresis" : descriptor.name);
+    telemetry.addBlock(blockSeconds, numSamples / getSampleRate());
+    telemetry.publish();
+}
+
+void WaveShaperAudioProcessor::processBlockBypassed(juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages)
+{
+    //the host's own bypass takes the same path as the parameter, so it gets the crossfade and latency matching too
+    hostBypassed = true;
+    processBlock(buffer, midiMessages);
+    hostBypassed = false;
+}
+
+void WaveShaperAudioProcessor::shapeChannel(float* channelData, int numSamples, const CurveDescriptor& curve, const CurveCoefficients& coefficients, const CurveTable* table)
+{
+    //shared table once the cache thread has it ready and the block fits it, direct math otherwise.
+    //The table is within CurveTable::maxError of the math, so going back and forth doesn't step the output.
+    if (table == nullptr || ! table->process(channelData, numSamples))
+        curve.process(channelData, numSamples, coefficients);
+}
+
+float WaveShaperAudioProcessor::sanitize(float* data, int numSamples, int& numClipped)
+{
+    //NaN, inf or absurd input would stick in the filter, oversampler and envelope state for good, so it becomes silence
+    //here. Same pass as the input metering, so it costs one compare and select per sample.
+    auto sum = 0.f;
+    auto clipped = 0;
+
+    for (int s = 0; s < numSamples; ++s)
+    {
+        auto x = std::abs(data[s]) < 1000.f ? data[s] : 0.f;
+        data[s] = x;
+
+        sum += x * x;
+        clipped += std::abs(x) >= 1.f ? 1 : 0;
+    }
+
+    numClipped += clipped;
+    return sum;
+}
+
+float WaveShaperAudioProcessor::sumOfSquares(const float* data, int numSamples, int& numClipped)
+{
+    auto sum = 0.f;
+    auto clipped = 0;
+
+    for (int s = 0; s < numSamples; ++s)
+    {
+        sum += data[s] * data[s];
+        clipped += std::abs(data[s]) >= 1.f ? 1 : 0;
+    }
 
+    numClipped += clipped;
+    return sum;
+}
+
+void WaveShaperAudioProcessor::setProcessingChunkSize(int numSamples)
+{
+    processingChunkSize.store(juce::jlimit(minChunkSize, maxChunkSize, numSamples), std::memory_order_relaxed);
+}
+
+int WaveShaperAudioProcessor::chooseOversamplingOrder() const
+{
+    auto choice = quality->getIndex();
+
+    if (choice != Quality::autoQuality)
+        return choice - 1;
+
+    //bounces always get the best we have, live playback gets whatever fits the budget
+    return isNonRealtime() ? maxOversamplingOrder : autoOrder;
+}
+
+void WaveShaperAudioProcessor::setOversamplingOrder(int order, bool crossfade)
+{
+    if (order > 0)
+        oversamplers[order]->reset();
+
+    latencyPads[order].reset();
+
+    //a switch in the middle of a fade drops what's left of the older order, which is quiet by then
+    if (crossfade)
+    {
+        fadingFromOrder = oversamplingOrder;
+        std::swap(hysteresis, fadingHysteresis);
+        orderFade.setCurrentAndTargetValue(0);
+        orderFade.setTargetValue(1);
     }
+
+    oversamplingOrder = order;
+    hysteresis.reset(); //its state belongs to the old rate
+
+    updateLatency();
+}
+
+void WaveShaperAudioProcessor::resetProcessingState()
+{
+    for (int order = 1; order <= maxOversamplingOrder; ++order)
+        oversamplers[order]->reset();
+
+    for (auto& pad : latencyPads)
+        pad.reset();
+
+    hysteresis.reset();
+    fadingHysteresis.reset();
+    emphasis.reset();
+    envelopeFollower.reset();
+    orderFade.setCurrentAndTargetValue(1);
 }
 
-void WaveShaperAudioProcessor::processQuadratic(int channel, juce::AudioBuffer<float>& buffer)
+int WaveShaperAudioProcessor::getOversamplingLatency(int order) const
 {
-    float* channelData = buffer.getWritePointer(channel);
+    return order > 0 ? juce::roundToInt(oversamplers[order]->getLatencyInSamples()) : 0;
+}
 
-    for (int s = 0; s < buffer.getNumSamples(); ++s)
+void WaveShaperAudioProcessor::updateLatency()
+{
+    //a fixed order reports its own latency; Auto reports the slowest order's, live or bouncing, and
+    //pads whatever it runs up to that
+    latencyQuality = quality->getIndex();
+    auto latency = latencyQuality == Quality::autoQuality ? getOversamplingLatency(maxOversamplingOrder)
+                                                          : getOversamplingLatency(latencyQuality - 1);
+
+    for (int order = 0; order <= maxOversamplingOrder; ++order)
     {
-        channelData[s] = channelData[s] * (abs(channelData[s]) + quadraticDistort->get()) / (pow(channelData[s], 2) + (quadraticDistort->get() - 1) * abs(channelData[s]) + 1);
+        padSamples[order] = juce::jmax(0, latency - getOversamplingLatency(order));
+        latencyPads[order].setDelay((float)padSamples[order]);
+    }
+
+    dryDelay.setDelay((float)latency);
+
+    if (latency != getLatencySamples())
+        setLatencySamples(latency);
+}
+
+void WaveShaperAudioProcessor::updateAutoQuality(double blockSeconds, int numSamples)
+{
+    if (quality->getIndex() != Quality::autoQuality || isNonRealtime() || numSamples == 0)
+        return;
+
+    //fraction of real time this instance needed for the block, smoothed so one late block doesn't switch anything
+    auto load = (float)(blockSeconds * getSampleRate() / numSamples);
+    cpuLoad += (load - cpuLoad) * .05f;
+
+    //give each setting a while before judging it, so auto doesn't keep crossfading back and forth
+    samplesSinceSwitch += numSamples;
+    if (samplesSinceSwitch < getSampleRate())
+        return;
 
+    if (cpuLoad > cpuBudget && autoOrder > 0)
+    {
+        --autoOrder;
+        cpuLoad *= .5f;
+        samplesSinceSwitch = 0;
+    }
+    else if (cpuLoad * 2 < cpuBudget * .75f && autoOrder < maxRealtimeOrder)
+    {
+        ++autoOrder;
+        cpuLoad *= 2;
+        samplesSinceSwitch = 0;
     }
 }
 
-void WaveShaperAudioProcessor::processFactor(int channel, juce::AudioBuffer<float>& buffer)
+void WaveShaperAudioProcessor::shapeInPlace(int curve, float drive, float* data, int numSamples)
 {
-    float* channelData = buffer.getWritePointer(channel);
+    auto& descriptor = CurveRegistry::getCurve(curve);
+    descriptor.process(data, numSamples, descriptor.prepare(drive));
+}
+
+float WaveShaperAudioProcessor::getAutoGain(int curve, ShaperMode mode, float morphPosition, const CascadeStage* cascade, int numCascadeStages) const
+{
+    //the level a registry curve leaves a sine at, going by the measured tables
+    auto through = [this](int index, float drive, float level) { return level - autoGainTables->getMakeupDecibels(index, drive, level); };
+
+    //last block's input level, which is close enough and already measured. Power average of the channels,
+    //then moved to where the shaper sees it.
+    auto power = 0.f;
+    auto numChannels = juce::jmin(getMainBusNumInputChannels(), 2);
+
+    for (int channel = 0; channel < numChannels; ++channel)
+        power += juce::Decibels::decibelsToGain(rmsIn[channel].load() * 2);
+
+    auto input = juce::Decibels::gainToDecibels(power / juce::jmax(1, numChannels)) * .5f + inGainValue->get();
+    auto level = input;
+
+    switch (mode)
+    {
+        case ShaperMode::hysteresisShaper:
+            //the model isn't a registry curve and has no table, so its output is taken to be as loud as its input
+            break;
+
+        case ShaperMode::morphShaper:
+        {
+            auto morphCurve = morphTarget->get() - 1;
+            auto from = through(curve, getDrive(curve), input);
+            level = from + morphPosition * (through(morphCurve, getDrive(morphCurve), input) - from);
+            break;
+        }
+
+        case ShaperMode::midSideShaper:
+        {
+            //each half through its own curve at its own level, and the halves add up as power in each channel
+            auto& side = CurveRegistry::getCurve(sideCurve->get() - 1);
+            auto sideIndex = (int)(&side - CurveRegistry::getCurves().data());
+            auto mid = through(curve, getDrive(curve), juce::Decibels::gainToDecibels(midSidePower[0]) * .5f + inGainValue->get());
+            auto sideLevel = through(sideIndex, juce::jmap(sideDrive->get(), side.minDrive, side.maxDrive),
+                                     juce::Decibels::gainToDecibels(midSidePower[1]) * .5f + inGainValue->get());
+
+            level = juce::Decibels::gainToDecibels(juce::Decibels::decibelsToGain(mid * 2) + juce::Decibels::decibelsToGain(sideLevel * 2)) * .5f;
+            break;
+        }
 
-    auto factor = 2 * factorDistort->get() / (1 - factorDistort->get());
+        case ShaperMode::dynamicShaper:
+        {
+            //the drive the envelope held the curve at on average last block
+            auto& descriptor = CurveRegistry::getCurve(curve);
+            auto drive = getDrive(curve) + (descriptor.maxDrive - descriptor.minDrive) * dynamicDepth->get() * envelopeMean;
+            level = through(curve, juce::jlimit(descriptor.minDrive, descriptor.maxDrive, drive), input);
+            break;
+        }
+
+        case ShaperMode::plainShaper:
+        default:
+            //when cascading, the selected curve is the cascade's first stage
+            if (numCascadeStages == 0)
+                level = through(curve, getDrive(curve), input);
+            break;
+    }
 
-    for (int s = 0; s < buffer.getNumSamples(); ++s)
+    //each stage at whatever level the one before left, plus its own gain
+    for (int stage = 0; stage < numCascadeStages; ++stage)
     {
-        channelData[s] = ((1 + factor) * channelData[s]) / (1 + factor * abs(channelData[s]));
+        auto& current = cascade[stage];
+        auto index = (int)(current.curve - CurveRegistry::getCurves().data());
+        level = through(index, current.coefficients.drive, level + juce::Decibels::gainToDecibels(current.gain));
     }
+
+    return juce::jlimit(-AutoGainTables::maxMakeup, AutoGainTables::maxMakeup, input - level);
 }
 
-void WaveShaperAudioProcessor::processGB(int channel, juce::AudioBuffer<float>& buffer)
+int WaveShaperAudioProcessor::prepareCascade(std::array<CascadeStage, maxCascadeStages>& stages, const CascadeStage& first, bool includeFirst) const
 {
-    float* channelData = buffer.getWritePointer(channel);
+    auto numStages = 0;
+
+    if (includeFirst)
+        stages[numStages++] = first;
 
-    for (int s = 0; s < buffer.getNumSamples(); ++s)
+    for (int stage = 0; stage < cascadeStages->get() - 1; ++stage)
     {
-        auto distort = channelData[s] * gbDistort->get();
-        auto constant = 1 + exp(sqrt(fabs(distort)) * -0.75);
+        //drive is stored normalized so it stays meaningful when the stage's curve changes
+        auto& curve = CurveRegistry::getCurve(stageCurves[stage]->get() - 1);
+        auto drive = juce::jmap(stageDrives[stage]->get(), curve.minDrive, curve.maxDrive);
 
-        channelData[s] = (exp(distort) - exp(-distort * constant)) / (exp(distort) + exp(-distort));
+        stages[numStages++] = { &curve, curve.prepare(drive), juce::Decibels::decibelsToGain(stageGains[stage]->get()) };
     }
+
+    return numStages;
+}
+
+int WaveShaperAudioProcessor::getSelectedCurve() const
+{
+    //typeSelect keeps its original 1 to 4 range so old automation still picks the same curves;
+    //curveType reaches the whole registry and takes over whenever it's set
+    auto extended = curveType->get();
+    return extended > 0 ? extended - 1 : typeSelect->get() - 1;
+}
+
+float WaveShaperAudioProcessor::getDrive(int curve) const
+{
+    return drives[(size_t)juce::jlimit(0, CurveRegistry::numCurves - 1, curve)]->get();
 }
 
 //==============================================================================
@@ -280,14 +1014,21 @@ juce::AudioProcessorEditor* WaveShaperAudioProcessor::createEditor()
 //==============================================================================
 void WaveShaperAudioProcessor::getStateInformation (juce::MemoryBlock& destData)
 {
+    //copyState takes the tree's lock, so a host saving from another thread can't catch it halfway through a change
     juce::MemoryOutputStream mos(destData, true);
-    apvts.state.writeToStream(mos); 
+    apvts.copyState().writeToStream(mos);
 }
 
 void WaveShaperAudioProcessor::setStateInformation (const void* data, int sizeInBytes)
 {
     auto tree = juce::ValueTree::readFromData(data, sizeInBytes);
     if (tree.isValid()) {
+        //sessions saved before the quality parameter existed ran at 1x with no latency, and keep doing so.
+        //replaceState would otherwise leave whatever value the parameter had before the load
+        if (! tree.getChildWithProperty("id", "quality").isValid())
+            tree.appendChild(juce::ValueTree("PARAM").setProperty("id", "quality", nullptr)
+                                                     .setProperty("value", (int)Quality::x1, nullptr), nullptr);
+
         apvts.replaceState(tree);
     }
 }
@@ -306,21 +1047,12 @@ float WaveShaperAudioProcessor::getOutRMS(int channel)
 
 juce::AudioProcessorValueTreeState::ParameterLayout WaveShaperAudioProcessor::createParameterLayout()
 {
-    using namespace juce;
-    AudioProcessorValueTreeState::ParameterLayout layout;
-
-    auto amountRange = NormalisableRange<float>(.01, .99, .01, 1);
-    auto amountGreaterRange = NormalisableRange<float>(.01, 10, .01, 1);
-    auto gainRange = NormalisableRange<float>(-20, 20, .1, 1);
-
-    layout.add(std::make_unique<AudioParameterFloat>("inGainValue", "Gain In", gainRange, 0));
-    layout.add(std::make_unique<AudioParameterInt>("typeSelect", "Disrotion Type", 1, 4, 1));
-    layout.add(std::make_unique<AudioParameterFloat>("sinDistort", "Sine Distortion Factor", amountRange, .5));
-    layout.add(std::make_unique<AudioParameterFloat>("quadraticDistort", "Quadratic Distortion Factor", amountGreaterRange, 1));
-    layout.add(std::make_unique<AudioParameterFloat>("factorDistort", "Factor Distortion Factor", amountRange, .5));
-    layout.add(std::make_unique<AudioParameterFloat>("gbDistort", "Gloubi Boulga Distortion Factor", amountGreaterRange, 1));
-    layout.add(std::make_unique<AudioParameterFloat>("outGainValue", "Gain Out", gainRange, 0));
-    layout.add(std::make_unique<AudioParameterBool>("bypass", "Bypassed", false));
+    juce::AudioProcessorValueTreeState::ParameterLayout layout;
+
+    WaveShaperParameters::forEach([&layout](const ParameterSpec& spec, const juce::String& id, const juce::String& name, int)
+    {
+        layout.add(makeParameter(spec, id, name));
+    });
 
     return layout;
 }
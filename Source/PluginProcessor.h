@@ -9,6 +9,14 @@
 #pragma once
 
 #include <JuceHeader.h>
+#include "CurveTableCache.h"
+#include "CurveRegistry.h"
+#include "Telemetry.h"
+#include "AutoGainTables.h"
+#include "HysteresisModel.h"
+#include "EmphasisFilter.h"
+#include "EnvelopeFollower.h"
+#include "Trace.h"
 
 //==============================================================================
 /**
@@ -32,10 +40,19 @@ public:
    #endif
 
     void processBlock (juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
-    void processSinusoidal(int channel, juce::AudioBuffer<float>& buffer);
-    void processQuadratic(int channel, juce::AudioBuffer<float>& buffer);
-    void processFactor(int channel, juce::AudioBuffer<float>& buffer);
-    void processGB(int channel, juce::AudioBuffer<float>& buffer);
+    void processBlockBypassed (juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
+    juce::AudioProcessorParameter* getBypassParameter() const override { return bypass; }
+
+    //Runs a registry curve over data in place, used to fill the shared CurveTables.
+    static void shapeInPlace(int curve, float drive, float* data, int numSamples);
+    static float getTableRange(int curve) { return CurveRegistry::getCurve(curve).tableRange; }
+
+    //Number of samples each stage handles before the next one runs. Safe to call while processing.
+    void setProcessingChunkSize(int numSamples);
+    int getProcessingChunkSize() const { return processingChunkSize.load(std::memory_order_relaxed); }
+
+    static constexpr int minChunkSize = 16;
+    static constexpr int maxChunkSize = 4096;
 
     //==============================================================================
     juce::AudioProcessorEditor* createEditor() override;
@@ -68,14 +85,100 @@ public:
 
 private:
     
-    enum WaveShaper {
-        none,
-        sinusoidal,
-        quadratic,
-        factor,
-        GloubiBoulga
+    enum Model {
+        curveModel,
+        hysteresisModel
+    };
+
+    enum StereoMode {
+        leftRightStereo,
+        midSideStereo
+    };
+
+    //which pass does the shaping this block, in the order processBlock picks them
+    enum class ShaperMode {
+        hysteresisShaper,
+        morphShaper,
+        midSideShaper,
+        dynamicShaper,
+        plainShaper
+    };
+
+    enum Quality {
+        autoQuality,
+        x1,
+        x2,
+        x4,
+        x8
     };
 
+    static constexpr int maxCascadeStages = 4;
+    static constexpr int maxOversamplingOrder = 3;  //8x, used for bounces
+    static constexpr int maxRealtimeOrder = 2;      //auto mode never goes past 4x while playing live
+    //Share of real time one instance may use in auto mode. Every plugin in a session shares the audio
+    //thread's real time, and big mixes run dozens of instances, so 1% each leaves room for the rest of
+    //the chain. It's a ceiling, not a target: auto only steps up while the next order, at twice the
+    //cost, would still land under three quarters of it.
+    static constexpr float cpuBudget = .01f;
+    static constexpr double orderFadeSeconds = .02; //crossfade between the old and new order when it changes
+
+    int getSelectedCurve() const; //zero based
+    float getDrive(int curve) const;
+    int prepareCascade(std::array<CascadeStage, maxCascadeStages>& stages, const CascadeStage& first, bool includeFirst) const;
+    float getAutoGain(int curve, ShaperMode mode, float morphPosition, const CascadeStage* cascade, int numCascadeStages) const;
+    void shapeChannel(float* channelData, int numSamples, const CurveDescriptor& curve, const CurveCoefficients& coefficients, const CurveTable* table);
+    static float sumOfSquares(const float* data, int numSamples, int& numClipped); //also counts samples at or above full scale
+    static float sanitize(float* data, int numSamples, int& numClipped);           //sumOfSquares that also zeroes garbage input
+
+    std::atomic<int> processingChunkSize{ 128 };
+    int preparedBlockSize = 1;
+
+    int chooseOversamplingOrder() const;
+    void setOversamplingOrder(int order, bool crossfade);
+    int getOversamplingLatency(int order) const;
+    void updateLatency();
+    void resetProcessingState(); //everything downstream of the dry split, back to silence
+    void updateAutoQuality(double blockSeconds, int numSamples);
+
+    std::array<std::unique_ptr<juce::dsp::Oversampling<float>>, maxOversamplingOrder + 1> oversamplers; //indexed by order, [0] is unused
+    int oversamplingOrder = 0;
+    int fadingFromOrder = 0;   //the order orderFade is leaving
+    int latencyQuality = -1;   //the quality choice the reported latency was worked out for
+    int autoOrder = maxRealtimeOrder;
+    float cpuLoad = 0;
+    int samplesSinceSwitch = 0;
+
+   #if WAVESHAPER_CURVE_TABLES
+    CurveTableCache::Handle curveTables{ &WaveShaperAudioProcessor::shapeInPlace, &WaveShaperAudioProcessor::getTableRange };
+   #endif
+    Telemetry::Publisher telemetry;
+   #if WAVESHAPER_TRACE
+    juce::SharedResourcePointer<Trace::Session> traceSession;
+   #endif
+    juce::SharedResourcePointer<AutoGainTables> autoGainTables;
+
+    juce::SmoothedValue<float, juce::ValueSmoothingTypes::Linear> morph;
+    juce::SmoothedValue<float, juce::ValueSmoothingTypes::Linear> bypassFade; //0 is processed, 1 is bypassed
+    juce::dsp::DelayLine<float, juce::dsp::DelayLineInterpolationTypes::None> dryDelay; //matches the reported latency
+    juce::AudioBuffer<float> dryBuffer;
+    juce::SmoothedValue<float, juce::ValueSmoothingTypes::Linear> orderFade; //0 is fadingFromOrder, 1 is oversamplingOrder
+    juce::AudioBuffer<float> orderFadeBuffer;                                 //the outgoing order's copy of a chunk
+
+    //Auto reports the latency of the slowest order whatever it runs, so the host never has to redo its
+    //compensation. Each order's output is delayed by whatever it lacks.
+    std::array<juce::dsp::DelayLine<float, juce::dsp::DelayLineInterpolationTypes::None>, maxOversamplingOrder + 1> latencyPads;
+    std::array<int, maxOversamplingOrder + 1> padSamples{};
+    bool hostBypassed = false; //set while processBlockBypassed runs
+    bool fullyBypassed = false; //last block took the bypass shortcut, so the processing state is stale
+    HysteresisModel hysteresis;
+    HysteresisModel fadingHysteresis; //keeps the outgoing order's state, which belongs to its rate
+    EmphasisFilter emphasis;
+    EnvelopeFollower envelopeFollower;
+    std::vector<float> envelope;    //base rate, one chunk
+    std::vector<float> driveBuffer; //oversampled rate, one chunk
+    std::array<float, 2> midSidePower{}; //last mid/side block's mid and side power, before inGain, for auto gain
+    float envelopeMean = 0;              //last dynamic block's average envelope, for auto gain
+
     juce::dsp::Gain<float> inGain;
     juce::dsp::Gain<float> outGain;
 
@@ -84,12 +187,32 @@ private:
 
     juce::AudioParameterBool* bypass{ nullptr };
     juce::AudioParameterInt* typeSelect{ nullptr };
-    juce::AudioParameterFloat* sinDistort{ nullptr };
-    juce::AudioParameterFloat* quadraticDistort{ nullptr };
-    juce::AudioParameterFloat* factorDistort{ nullptr };
-    juce::AudioParameterFloat* gbDistort{ nullptr };
+    juce::AudioParameterInt* curveType{ nullptr };
+    std::array<juce::AudioParameterFloat*, CurveRegistry::numCurves> drives{}; //one per registry curve
     juce::AudioParameterFloat* inGainValue{ nullptr };
     juce::AudioParameterFloat* outGainValue{ nullptr };
+    juce::AudioParameterChoice* quality{ nullptr };
+    juce::AudioParameterInt* morphTarget{ nullptr };
+    juce::AudioParameterFloat* morphAmount{ nullptr };
+    juce::AudioParameterBool* autoGain{ nullptr };
+    juce::AudioParameterChoice* model{ nullptr };
+    juce::AudioParameterFloat* hysteresisDrive{ nullptr };
+    juce::AudioParameterFloat* hysteresisWidth{ nullptr };
+    juce::AudioParameterFloat* emphasisGain{ nullptr };
+    juce::AudioParameterFloat* emphasisFrequency{ nullptr };
+    juce::AudioParameterChoice* stereoMode{ nullptr };
+    juce::AudioParameterInt* sideCurve{ nullptr };
+    juce::AudioParameterFloat* sideDrive{ nullptr };
+    juce::AudioParameterFloat* dynamicDepth{ nullptr };
+    juce::AudioParameterFloat* dynamicAttack{ nullptr };
+    juce::AudioParameterFloat* dynamicRelease{ nullptr };
+    juce::AudioParameterChoice* dynamicSource{ nullptr };
+    juce::AudioParameterInt* cascadeStages{ nullptr };
+    std::array<juce::AudioParameterInt*, maxCascadeStages - 1> stageCurves{};   //stages 2 and up, stage 1 is the selected curve
+    std::array<juce::AudioParameterFloat*, maxCascadeStages - 1> stageDrives{};
+    std::array<juce::AudioParameterFloat*, maxCascadeStages - 1> stageGains{};
+
+    friend struct WaveShaperParameters; //the parameter tables, which bind straight to the members above
     //==============================================================================
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (WaveShaperAudioProcessor)
 };
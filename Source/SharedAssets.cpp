@@ -0,0 +1,31 @@
+/*
+  ==============================================================================
+
+    SharedAssets.cpp
+    Created: 20 Oct 2026 3:12:44am
+    Author:  kylew
+
+  ==============================================================================
+*/
+
+#include "SharedAssets.h"
+
+const juce::Image& SharedAssets::getLogo()
+{
+    JUCE_ASSERT_MESSAGE_THREAD
+
+    if (logo.isNull())
+        logo = juce::ImageFileFormat::loadFrom(BinaryData::KITIK_LOGO_NO_BKGD_png, (size_t)BinaryData::KITIK_LOGO_NO_BKGD_pngSize);
+
+    return logo;
+}
+
+juce::Typeface::Ptr SharedAssets::getTitleTypeface()
+{
+    JUCE_ASSERT_MESSAGE_THREAD
+
+    if (titleTypeface == nullptr)
+        titleTypeface = juce::Typeface::createSystemTypefaceFor(BinaryData::OFFSHORE_TTF, (size_t)BinaryData::OFFSHORE_TTFSize);
+
+    return titleTypeface;
+}
@@ -0,0 +1,33 @@
+/*
+  ==============================================================================
+
+    SharedAssets.h
+    Created: 20 Oct 2026 3:12:44am
+    Author:  kylew
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+//==============================================================================
+/** The logo and title typeface, decoded once for the whole process and only when an editor
+    first draws. Hold one through a SharedResourcePointer; the assets go away with the last editor.
+
+    Message thread only.
+*/
+class SharedAssets
+{
+public:
+    SharedAssets() = default;
+
+    const juce::Image& getLogo();
+    juce::Typeface::Ptr getTitleTypeface();
+
+private:
+    juce::Image logo;
+    juce::Typeface::Ptr titleTypeface;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SharedAssets)
+};
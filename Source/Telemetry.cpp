@@ -0,0 +1,275 @@
+/*
+  ==============================================================================
+
+    Telemetry.cpp
+    Created: 19 Oct 2026 10:22:51pm
+    Author:  kylew
+
+  ==============================================================================
+*/
+
+#include "Telemetry.h"
+
+#if ! JUCE_WINDOWS
+ #include <unistd.h>
+#endif
+
+juce::File Telemetry::getFolder()
+{
+    return juce::File::getSpecialLocation(juce::File::tempDirectory).getChildFile("WaveShaperTelemetry");
+}
+
+Telemetry::ReadResult Telemetry::read(const Slot& slot, Snapshot& result) noexcept
+{
+    if (slot.inUse.load(std::memory_order_acquire) == 0)
+        return ReadResult::unused;
+
+    for (int attempt = 0; attempt < maxReadAttempts; ++attempt)
+    {
+        auto before = slot.sequence.load(std::memory_order_acquire);
+
+        if ((before & 1) == 0)
+        {
+            std::memcpy(&result, &slot.data, sizeof(Snapshot));
+            std::atomic_thread_fence(std::memory_order_acquire);
+
+            if (slot.sequence.load(std::memory_order_relaxed) == before)
+                return ReadResult::valid;
+        }
+
+        juce::Thread::yield();
+    }
+
+    return ReadResult::torn;
+}
+
+namespace
+{
+    juce::String getLockName(const juce::File& file)
+    {
+        return "WaveShaperTelemetry_" + file.getFileNameWithoutExtension();
+    }
+
+    //Where the posix InterProcessLock keeps the file it locks, see juce_SharedCode_posix.h. It's
+    //never deleted by JUCE, so it would pile up next to the telemetry files. Windows uses a named
+    //mutex, nothing to clean up there.
+    juce::File getLockFile(const juce::File& file)
+    {
+       #if JUCE_WINDOWS
+        juce::ignoreUnused(file);
+        return {};
+       #elif JUCE_MAC
+        auto name = getLockName(file);
+        auto lockFile = juce::File("~/Library/Caches/com.juce.locks").getChildFile(name);
+        return lockFile.existsAsFile() ? lockFile : juce::File("/tmp/com.juce.locks").getChildFile(name);
+       #else
+        juce::File folder("/var/tmp");
+
+        if (! folder.isDirectory())
+            folder = juce::File("/tmp");
+
+        return folder.getChildFile(getLockName(file));
+       #endif
+    }
+
+    void deleteLockFile(const juce::File& file)
+    {
+        auto lockFile = getLockFile(file);
+
+        if (lockFile != juce::File())
+            lockFile.deleteFile();
+    }
+
+    //fcntl locks belong to the process, not the lock object. Entering a lock this process already holds
+    //succeeds, and exiting it again closes the fd, which drops the owner's lock as well. That happens
+    //when the VST3 and AU are loaded side by side, each with its own Region, so on posix file names
+    //start with the id of the process that made them and ours are never tested. Named mutexes on
+    //Windows belong to a thread, there the lock itself tells siblings apart.
+    juce::String getProcessPrefix()
+    {
+       #if JUCE_WINDOWS
+        return {};
+       #else
+        return juce::String((int)getpid()) + "-";
+       #endif
+    }
+}
+
+bool Telemetry::isOrphaned(const juce::File& file)
+{
+   #if ! JUCE_WINDOWS
+    if (file.getFileName().startsWith(getProcessPrefix()))
+        return false;
+   #endif
+
+    juce::InterProcessLock lock(getLockName(file));
+
+    if (! lock.enter(0))
+        return false;
+
+    lock.exit();
+    return true;
+}
+
+bool Telemetry::removeFile(const juce::File& file)
+{
+    if (! file.deleteFile())
+        return false;
+
+    deleteLockFile(file);
+    return true;
+}
+
+int Telemetry::removeOrphanedFiles()
+{
+    auto numRemoved = 0;
+
+    for (auto& file : getFolder().findChildFiles(juce::File::findFiles, false, "*.telemetry"))
+        if (isOrphaned(file) && removeFile(file))
+            ++numRemoved;
+
+    return numRemoved;
+}
+
+//==============================================================================
+Telemetry::Region::Region()
+{
+    static_assert(std::atomic<juce::uint32>::is_always_lock_free, "slots are shared between processes");
+
+    auto folder = getFolder();
+    folder.createDirectory();
+
+    //one file per Region, named so two can't collide. The process id goes first, see isOrphaned
+    file = folder.getChildFile(getProcessPrefix() + juce::String(juce::Time::currentTimeMillis()) + "-"
+                               + juce::String::toHexString(juce::Random::getSystemRandom().nextInt64())).withFileExtension("telemetry");
+
+    //the lock goes first, so a reader can never find the file without an owner and delete it
+    ownerLock = std::make_unique<juce::InterProcessLock>(getLockName(file));
+
+    if (! ownerLock->enter(0))
+    {
+        ownerLock.reset();
+        return;
+    }
+
+    //nobody else cleans up after a crashed host. Files of this process, ours or a sibling binary's,
+    //are skipped by isOrphaned, so the sweep can't take one for an orphan
+    removeOrphanedFiles();
+
+    auto size = sizeof(Header) + sizeof(Slot) * maxSlots;
+
+    {
+        juce::FileOutputStream out(file);
+        if (! out.openedOk())
+            return;
+
+        Header header{ magic, version, (juce::uint32)maxSlots, (juce::uint32)sizeof(Slot) };
+        out.write(&header, sizeof(header));
+
+        juce::MemoryBlock zeros(size - sizeof(Header), true);
+        out.write(zeros.getData(), zeros.getSize());
+    }
+
+    mapping = std::make_unique<juce::MemoryMappedFile>(file, juce::MemoryMappedFile::readWrite, false);
+
+    if (mapping->getData() == nullptr || mapping->getSize() < size)
+    {
+        mapping.reset();
+        return;
+    }
+
+    slots = reinterpret_cast<Slot*>(static_cast<char*>(mapping->getData()) + sizeof(Header));
+}
+
+Telemetry::Region::~Region()
+{
+    mapping.reset();
+
+    if (ownerLock == nullptr)
+        return;
+
+    //the lock file can only go once the lock is dropped
+    file.deleteFile();
+    ownerLock->exit();
+    deleteLockFile(file);
+}
+
+Telemetry::Slot* Telemetry::Region::claimSlot() noexcept
+{
+    if (slots == nullptr)
+        return nullptr;
+
+    for (int i = 0; i < maxSlots; ++i)
+    {
+        juce::uint32 expected = 0;
+
+        if (slots[i].inUse.compare_exchange_strong(expected, 1, std::memory_order_acq_rel))
+            return &slots[i];
+    }
+
+    return nullptr;
+}
+
+void Telemetry::Region::releaseSlot(Slot* slot) noexcept
+{
+    if (slot != nullptr)
+        slot->inUse.store(0, std::memory_order_release);
+}
+
+//==============================================================================
+Telemetry::Publisher::Publisher()
+    : slot(region->claimSlot())
+{
+    publish();
+}
+
+Telemetry::Publisher::~Publisher()
+{
+    region->releaseSlot(slot);
+}
+
+void Telemetry::Publisher::addBlock(double blockSeconds, double blockDuration) noexcept
+{
+    ++local.blockCount;
+    local.totalBlockSeconds += blockSeconds;
+    local.maxBlockSeconds = juce::jmax(local.maxBlockSeconds, blockSeconds);
+
+    if (blockSeconds > blockDuration)
+        ++local.overruns;
+}
+
+void Telemetry::Publisher::setCurve(int curve, const char* name) noexcept
+{
+    if (curve == local.curve)
+        return;
+
+    local.curve = curve;
+    std::strncpy(local.curveName, name, sizeof(local.curveName) - 1);
+}
+
+void Telemetry::Publisher::setLevels(int channel, float inputRms, float outputRms, int inputClips, int outputClips) noexcept
+{
+    if (! juce::isPositiveAndBelow(channel, 2))
+        return;
+
+    local.inputRms[channel] = inputRms;
+    local.outputRms[channel] = outputRms;
+    local.inputClips += (juce::uint64)inputClips;
+    local.outputClips += (juce::uint64)outputClips;
+}
+
+void Telemetry::Publisher::publish() noexcept
+{
+    if (slot == nullptr)
+        return;
+
+    local.lastUpdateMs = juce::Time::currentTimeMillis();
+
+    auto sequence = slot->sequence.load(std::memory_order_relaxed);
+    slot->sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    std::memcpy(&slot->data, &local, sizeof(Snapshot));
+
+    slot->sequence.store(sequence + 2, std::memory_order_release);
+}
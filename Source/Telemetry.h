@@ -0,0 +1,122 @@
+/*
+  ==============================================================================
+
+    Telemetry.h
+    Created: 19 Oct 2026 10:22:51pm
+    Author:  kylew
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+/** Health counters published by every instance into a memory mapped file, one file per
+    process, so a monitoring tool can read them without going anywhere near the audio thread.
+
+    Each instance owns one Slot. The audio thread updates it seqlock style: the sequence is
+    odd while a write is in progress, and a reader retries until it sees the same even
+    sequence before and after copying. Writers never wait and readers never block them.
+*/
+namespace Telemetry
+{
+    constexpr juce::uint32 magic = 0x4b575354; //"KWST"
+    constexpr juce::uint32 version = 1;
+    constexpr int maxSlots = 256;
+    constexpr int maxReadAttempts = 64; //a publish takes microseconds, a slot odd for longer belongs to a dead writer
+
+    struct Snapshot
+    {
+        juce::uint64 blockCount = 0;
+        juce::uint64 overruns = 0;          //blocks that took longer than their own duration
+        juce::uint64 inputClips = 0;        //samples at or above full scale
+        juce::uint64 outputClips = 0;
+        double totalBlockSeconds = 0;
+        double maxBlockSeconds = 0;
+        juce::int64 lastUpdateMs = 0;       //Time::currentTimeMillis() of the last publish
+        juce::int32 curve = -1;
+        float inputRms[2] = { -60.f, -60.f };
+        float outputRms[2] = { -60.f, -60.f };
+        char curveName[24] = {};
+    };
+
+    struct Slot
+    {
+        std::atomic<juce::uint32> sequence;
+        std::atomic<juce::uint32> inUse;
+        Snapshot data;
+    };
+
+    struct Header
+    {
+        juce::uint32 magic, version, numSlots, slotSize;
+    };
+
+    //Folder holding one .telemetry file per process that has the plugin loaded.
+    juce::File getFolder();
+
+    enum class ReadResult
+    {
+        unused,
+        valid,
+        torn    //a write never finished, or kept racing the reader for maxReadAttempts
+    };
+
+    //Copies a consistent snapshot out of a slot. Gives up after maxReadAttempts rather than wait for
+    //a writer that may have crashed halfway through a publish.
+    ReadResult read(const Slot& slot, Snapshot& result) noexcept;
+
+    //True when no running process owns the file any more, e.g. it was left behind by a crash.
+    //Each Region holds an InterProcessLock for its file, and the OS drops it when the process dies.
+    //Files made by this process are never orphaned, whichever of its plugin binaries made them.
+    bool isOrphaned(const juce::File& file);
+
+    //Deletes a telemetry file along with the lock file its InterProcessLock left behind, if any.
+    bool removeFile(const juce::File& file);
+
+    //Deletes every orphaned file in getFolder(), returns how many went.
+    int removeOrphanedFiles();
+
+    //==============================================================================
+    /** The mapped file for this process, shared by all instances through a SharedResourcePointer. */
+    class Region
+    {
+    public:
+        Region();
+        ~Region();
+
+        Slot* claimSlot() noexcept;
+        void releaseSlot(Slot* slot) noexcept;
+
+    private:
+        juce::File file;
+        std::unique_ptr<juce::InterProcessLock> ownerLock; //held for the life of the file
+        std::unique_ptr<juce::MemoryMappedFile> mapping;
+        Slot* slots = nullptr;
+
+        JUCE_DECLARE_NON_COPYABLE(Region)
+    };
+
+    //==============================================================================
+    /** One instance's view of its slot. The setters only touch a local copy, publish() makes it
+        visible to readers. Everything but the constructor and destructor is audio thread safe.
+    */
+    class Publisher
+    {
+    public:
+        Publisher();
+        ~Publisher();
+
+        void addBlock(double blockSeconds, double blockDuration) noexcept;
+        void setCurve(int curve, const char* name) noexcept;
+        void setLevels(int channel, float inputRms, float outputRms, int inputClips, int outputClips) noexcept;
+        void publish() noexcept;
+
+    private:
+        juce::SharedResourcePointer<Region> region;
+        Slot* slot = nullptr;
+        Snapshot local;
+
+        JUCE_DECLARE_NON_COPYABLE(Publisher)
+    };
+}
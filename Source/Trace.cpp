@@ -0,0 +1,175 @@
+/*
+  ==============================================================================
+
+    Trace.cpp
+    Created: 20 Oct 2026 5:21:07am
+    Author:  kylew
+
+  ==============================================================================
+*/
+
+#include "Trace.h"
+
+#if WAVESHAPER_TRACE
+
+std::atomic<Trace::Session*> Trace::Session::current{ nullptr };
+std::atomic<int> Trace::Session::nextGeneration{ 1 };
+
+juce::File Trace::getFolder()
+{
+    return juce::File::getSpecialLocation(juce::File::tempDirectory).getChildFile("WaveShaperTrace");
+}
+
+//==============================================================================
+Trace::Session::Session()
+    : juce::Thread("Trace Writer"),
+      rings(new Ring[maxThreads]),
+      generation(nextGeneration++),
+      startTicks(juce::Time::getHighResolutionTicks())
+{
+    auto folder = getFolder();
+    folder.createDirectory();
+
+    auto file = folder.getChildFile(juce::String(juce::Time::currentTimeMillis()) + "-"
+                                    + juce::String::toHexString(juce::Random::getSystemRandom().nextInt64())).withFileExtension("json");
+
+    stream = std::make_unique<juce::FileOutputStream>(file);
+
+    if (! stream->openedOk())
+    {
+        stream.reset();
+        return; //nothing to write to, so nothing gets recorded
+    }
+
+    write("[");
+
+    current.store(this, std::memory_order_release);
+    startThread(juce::Thread::Priority::low);
+}
+
+Trace::Session::~Session()
+{
+    auto* self = this;
+    current.compare_exchange_strong(self, nullptr);
+
+    stopThread(2000);
+
+    if (stream == nullptr)
+        return;
+
+    drain();
+
+    auto dropped = 0u;
+    for (int i = 0; i < juce::jmin(numRings.load(), maxThreads); ++i)
+        dropped += rings[i].dropped.load();
+
+    if (dropped > 0)
+        write(juce::String(firstEvent ? "" : ",\n") + "{\"name\":\"dropped events\",\"ph\":\"i\",\"s\":\"g\",\"pid\":1,\"tid\":0,\"ts\":"
+              + juce::String(juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - startTicks) * 1.0e6, 3)
+              + ",\"args\":{\"count\":" + juce::String(dropped) + "}}");
+
+    write("\n]\n");
+    stream->flush();
+}
+
+void Trace::Session::record(const char* name, juce::int64 start, juce::int64 end) noexcept
+{
+    //each thread remembers its ring, and which session it belongs to in case sessions come and go
+    struct ThreadRing
+    {
+        int generation = 0;
+        Ring* ring = nullptr;
+    };
+
+    static thread_local ThreadRing threadRing;
+
+    auto* session = current.load(std::memory_order_acquire);
+    if (session == nullptr)
+        return;
+
+    if (threadRing.generation != session->generation)
+    {
+        auto index = session->numRings.fetch_add(1);
+
+        threadRing.generation = session->generation;
+        threadRing.ring = index < maxThreads ? &session->rings[index] : nullptr;
+
+        if (threadRing.ring != nullptr)
+            threadRing.ring->threadID = (juce::uint64)(juce::pointer_sized_uint)juce::Thread::getCurrentThreadId();
+    }
+
+    auto* ring = threadRing.ring;
+    if (ring == nullptr)
+        return;
+
+    auto position = ring->writeIndex.load(std::memory_order_relaxed);
+
+    if (position - ring->readIndex.load(std::memory_order_acquire) >= (juce::uint32)ringSize)
+    {
+        ring->dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    ring->events[position & (ringSize - 1)] = { name, start, end };
+    ring->writeIndex.store(position + 1, std::memory_order_release);
+}
+
+void Trace::Session::run()
+{
+    while (! threadShouldExit())
+    {
+        wait(drainIntervalMs);
+        drain();
+    }
+}
+
+void Trace::Session::drain()
+{
+    auto toMicroseconds = 1.0e6 / (double)juce::Time::getHighResolutionTicksPerSecond();
+
+    for (int i = 0; i < juce::jmin(numRings.load(), maxThreads); ++i)
+    {
+        auto& ring = rings[i];
+        auto read = ring.readIndex.load(std::memory_order_relaxed);
+        auto end = ring.writeIndex.load(std::memory_order_acquire);
+
+        if (read == end)
+            continue;
+
+        //thread IDs are too long for some viewers, so threads are numbered by ring
+        auto tid = juce::String(i + 1);
+
+        if (! ring.named)
+        {
+            write(juce::String(firstEvent ? "\n" : ",\n") + "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" + tid
+                  + ",\"args\":{\"name\":\"Thread " + juce::String::toHexString((juce::int64)ring.threadID) + "\"}}");
+            ring.named = true;
+            firstEvent = false;
+        }
+
+        juce::String json;
+
+        for (; read != end; ++read)
+        {
+            auto& event = ring.events[read & (ringSize - 1)];
+
+            json << ",\n{\"name\":\"" << event.name << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << tid
+                 << ",\"ts\":" << juce::String((double)(event.start - startTicks) * toMicroseconds, 3)
+                 << ",\"dur\":" << juce::String((double)(event.end - event.start) * toMicroseconds, 3) << "}";
+        }
+
+        ring.readIndex.store(read, std::memory_order_release);
+        write(json);
+    }
+
+    if (stream != nullptr)
+        stream->flush();
+}
+
+void Trace::Session::write(const juce::String& json)
+{
+    if (stream != nullptr)
+        stream->writeText(json, false, false, nullptr);
+}
+
+#endif
@@ -0,0 +1,112 @@
+/*
+  ==============================================================================
+
+    Trace.h
+    Created: 20 Oct 2026 5:21:07am
+    Author:  kylew
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+//Build with WAVESHAPER_TRACE=1 to record trace zones. Otherwise the zones and everything
+//in here compile to nothing.
+#ifndef WAVESHAPER_TRACE
+ #define WAVESHAPER_TRACE 0
+#endif
+
+#if WAVESHAPER_TRACE
+
+/** Scoped timing zones written out as Chrome trace event JSON, which Perfetto and
+    chrome://tracing open directly.
+
+    Every thread that records gets its own preallocated ring the first time it closes a zone,
+    so the audio thread only ever reads the clock and writes one event into a ring nobody
+    else writes to. A background thread drains the rings into a file in getFolder(), one
+    file per session. When a ring is full the event is dropped and counted, never waited on.
+*/
+namespace Trace
+{
+    constexpr int maxThreads = 16;
+    constexpr int ringSize = 1 << 14;   //events per thread, a power of two
+    constexpr int drainIntervalMs = 50;
+
+    struct Event
+    {
+        const char* name;   //string literals only, the pointer is kept until the event is written
+        juce::int64 start, end;
+    };
+
+    //Folder holding one .json trace per session.
+    juce::File getFolder();
+
+    //==============================================================================
+    /** Owns the rings and the trace file. Hold one through a SharedResourcePointer for as long
+        as zones should be recorded; it has to outlive every thread that records into it.
+    */
+    class Session : private juce::Thread
+    {
+    public:
+        Session();
+        ~Session() override;
+
+        //Called when a Zone closes. Lock free and allocation free.
+        static void record(const char* name, juce::int64 start, juce::int64 end) noexcept;
+
+    private:
+        struct Ring
+        {
+            std::array<Event, ringSize> events;
+            std::atomic<juce::uint32> writeIndex{ 0 }, readIndex{ 0 };
+            std::atomic<juce::uint32> dropped{ 0 };
+            juce::uint64 threadID = 0;  //set before the first event is published
+            bool named = false;         //drain thread only
+        };
+
+        void run() override;
+        void drain();
+        void write(const juce::String& json);
+
+        std::unique_ptr<Ring[]> rings;
+        std::atomic<int> numRings{ 0 };
+        int generation = 0;
+
+        std::unique_ptr<juce::FileOutputStream> stream;
+        juce::int64 startTicks = 0;
+        bool firstEvent = true;
+
+        static std::atomic<Session*> current;
+        static std::atomic<int> nextGeneration;
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Session)
+    };
+
+    //==============================================================================
+    //Times the enclosing scope. Use WAVESHAPER_TRACE_ZONE rather than this directly.
+    class Zone
+    {
+    public:
+        explicit Zone(const char* zoneName) noexcept
+            : name(zoneName), start(juce::Time::getHighResolutionTicks())
+        {
+        }
+
+        ~Zone() noexcept
+        {
+            Session::record(name, start, juce::Time::getHighResolutionTicks());
+        }
+
+    private:
+        const char* name;
+        juce::int64 start;
+
+        JUCE_DECLARE_NON_COPYABLE (Zone)
+    };
+}
+
+ #define WAVESHAPER_TRACE_ZONE(name) Trace::Zone JUCE_JOIN_MACRO(traceZone, __LINE__) (name)
+#else
+ #define WAVESHAPER_TRACE_ZONE(name)
+#endif
@@ -0,0 +1,226 @@
+/*
+  ==============================================================================
+
+    GraphRenderer.cpp
+    Created: 19 Oct 2026 5:03:18pm
+    Author:  kylew
+
+  ==============================================================================
+*/
+
+#include "GraphRenderer.h"
+#include "../../Source/PluginProcessor.h"
+
+namespace
+{
+    //Takes the place of a plugin we don't load: effects pass their input through, instruments are silent.
+    class StandInProcessor : public juce::AudioProcessor
+    {
+    public:
+        StandInProcessor(const juce::String& pluginName, int numInputs, int numOutputs)
+            : AudioProcessor(makeBuses(numInputs, numOutputs)), name(pluginName)
+        {
+        }
+
+        void prepareToPlay(double, int) override {}
+        void releaseResources() override {}
+
+        void processBlock(juce::AudioBuffer<float>& buffer, juce::MidiBuffer&) override
+        {
+            for (auto i = getTotalNumInputChannels(); i < getTotalNumOutputChannels(); ++i)
+                buffer.clear(i, 0, buffer.getNumSamples());
+        }
+
+        juce::AudioProcessorEditor* createEditor() override { return nullptr; }
+        bool hasEditor() const override { return false; }
+
+        const juce::String getName() const override { return name; }
+        bool acceptsMidi() const override { return false; }
+        bool producesMidi() const override { return false; }
+        double getTailLengthSeconds() const override { return 0.0; }
+
+        int getNumPrograms() override { return 1; }
+        int getCurrentProgram() override { return 0; }
+        void setCurrentProgram(int) override {}
+        const juce::String getProgramName(int) override { return {}; }
+        void changeProgramName(int, const juce::String&) override {}
+
+        void getStateInformation(juce::MemoryBlock&) override {}
+        void setStateInformation(const void*, int) override {}
+
+    private:
+        static BusesProperties makeBuses(int numInputs, int numOutputs)
+        {
+            BusesProperties buses;
+
+            if (numInputs > 0)
+                buses = buses.withInput("Input", juce::AudioChannelSet::canonicalChannelSet(numInputs), true);
+
+            if (numOutputs > 0)
+                buses = buses.withOutput("Output", juce::AudioChannelSet::canonicalChannelSet(numOutputs), true);
+
+            return buses;
+        }
+
+        juce::String name;
+    };
+}
+
+//==============================================================================
+GraphRenderer::GraphRenderer(const juce::File& graph, const juce::File& inputFile, const juce::File& outputFile,
+                             int renderBlockSize, int processingChunkSize)
+    : ThreadPoolJob("Render " + outputFile.getFileName()),
+      graphFile(graph), input(inputFile), output(outputFile),
+      blockSize(renderBlockSize), chunkSize(processingChunkSize)
+{
+    formatManager.registerBasicFormats();
+}
+
+GraphRenderer::~GraphRenderer()
+{
+}
+
+juce::Result GraphRenderer::load()
+{
+    using namespace juce;
+    using NodeID = AudioProcessorGraph::NodeID;
+
+    auto xml = parseXML(graphFile);
+    if (xml == nullptr || ! xml->hasTagName("FILTERGRAPH"))
+        return result = Result::fail(graphFile.getFullPathName() + " is not a filtergraph");
+
+    reader.reset(formatManager.createReaderFor(input));
+    if (reader == nullptr)
+        return result = Result::fail("Can't read " + input.getFullPathName());
+
+    auto numChannels = (int)reader->numChannels;
+    auto sampleRate = reader->sampleRate;
+
+    graph = std::make_unique<AudioProcessorGraph>();
+    graph->setPlayConfigDetails(numChannels, numChannels, sampleRate, blockSize);
+
+    for (auto* filter : xml->getChildWithTagNameIterator("FILTER"))
+    {
+        auto* plugin = filter->getChildByName("PLUGIN");
+        if (plugin == nullptr)
+            continue;
+
+        auto name = plugin->getStringAttribute("name");
+        std::unique_ptr<AudioProcessor> processor;
+
+        if (name == "Audio Input")
+        {
+            processor = std::make_unique<AudioProcessorGraph::AudioGraphIOProcessor>(AudioProcessorGraph::AudioGraphIOProcessor::audioInputNode);
+        }
+        else if (name == "Audio Output")
+        {
+            processor = std::make_unique<AudioProcessorGraph::AudioGraphIOProcessor>(AudioProcessorGraph::AudioGraphIOProcessor::audioOutputNode);
+        }
+        else if (name == "MIDI Input" || name == "MIDI Output")
+        {
+            continue;
+        }
+        else if (name == "WaveShaper")
+        {
+            auto waveShaper = std::make_unique<WaveShaperAudioProcessor>();
+
+            if (auto* state = filter->getChildByName("STATE"))
+            {
+                MemoryBlock data;
+                if (data.fromBase64Encoding(state->getAllSubText().trim()) && data.getSize() > 0)
+                    waveShaper->setStateInformation(data.getData(), (int)data.getSize());
+            }
+
+            if (chunkSize > 0)
+                waveShaper->setProcessingChunkSize(chunkSize);
+
+            processor = std::move(waveShaper);
+        }
+        else
+        {
+            auto isInstrument = plugin->getIntAttribute("isInstrument") != 0;
+            warnings.add("\"" + name + "\" is replaced by " + (isInstrument ? "silence" : "a pass-through"));
+
+            processor = std::make_unique<StandInProcessor>(name, isInstrument ? 0 : plugin->getIntAttribute("numInputs"),
+                                                           plugin->getIntAttribute("numOutputs"));
+        }
+
+        if (graph->addNode(std::move(processor), NodeID((uint32)filter->getIntAttribute("uid"))) == nullptr)
+            warnings.add("Couldn't add \"" + name + "\"");
+    }
+
+    for (auto* connection : xml->getChildWithTagNameIterator("CONNECTION"))
+    {
+        AudioProcessorGraph::Connection c{ { NodeID((uint32)connection->getIntAttribute("srcFilter")), connection->getIntAttribute("srcChannel") },
+                                           { NodeID((uint32)connection->getIntAttribute("dstFilter")), connection->getIntAttribute("dstChannel") } };
+
+        //MIDI connections and anything touching a node we skipped are dropped quietly
+        if (c.source.isMIDI() || graph->getNodeForId(c.source.nodeID) == nullptr || graph->getNodeForId(c.destination.nodeID) == nullptr)
+            continue;
+
+        if (! graph->addConnection(c))
+            warnings.add("Couldn't connect " + String(c.source.nodeID.uid) + " to " + String(c.destination.nodeID.uid));
+    }
+
+    graph->setNonRealtime(true);
+    graph->prepareToPlay(sampleRate, blockSize);
+
+    return result;
+}
+
+juce::ThreadPoolJob::JobStatus GraphRenderer::runJob()
+{
+    using namespace juce;
+
+    if (graph == nullptr || result.failed())
+        return jobHasFinished;
+
+    output.deleteFile();
+    auto stream = output.createOutputStream();
+
+    WavAudioFormat wav;
+    std::unique_ptr<AudioFormatWriter> writer(stream != nullptr ? wav.createWriterFor(stream.get(), reader->sampleRate, reader->numChannels, 24, {}, 0)
+                                                                : nullptr);
+    if (writer == nullptr)
+    {
+        result = Result::fail("Can't write " + output.getFullPathName());
+        return jobHasFinished;
+    }
+
+    stream.release(); //the writer owns it now
+
+    auto numChannels = (int)reader->numChannels;
+    auto length = reader->lengthInSamples;
+    auto latency = (int64)graph->getLatencySamples();
+
+    AudioBuffer<float> buffer(numChannels, blockSize);
+    MidiBuffer midi;
+
+    auto start = Time::getHighResolutionTicks();
+
+    //keep feeding silence past the end of the file until the latency has been flushed,
+    //and drop the same amount from the front so the output lines up with the input
+    for (int64 position = 0; position < length + latency && ! shouldExit(); position += blockSize)
+    {
+        auto numSamples = (int)jmin((int64)blockSize, length + latency - position);
+
+        buffer.setSize(numChannels, numSamples, false, false, true);
+        buffer.clear();
+
+        if (position < length)
+            reader->read(&buffer, 0, (int)jmin((int64)numSamples, length - position), position, true, true);
+
+        midi.clear();
+        graph->processBlock(buffer, midi);
+
+        auto skip = (int)jlimit((int64)0, (int64)numSamples, latency - position);
+        if (skip < numSamples)
+            writer->writeFromAudioSampleBuffer(buffer, skip, numSamples - skip);
+    }
+
+    renderSeconds = Time::highResolutionTicksToSeconds(Time::getHighResolutionTicks() - start);
+    audioSeconds = (double)length / reader->sampleRate;
+
+    graph->releaseResources();
+    return jobHasFinished;
+}
@@ -0,0 +1,54 @@
+/*
+  ==============================================================================
+
+    GraphRenderer.h
+    Created: 19 Oct 2026 5:03:18pm
+    Author:  kylew
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+//==============================================================================
+/** Renders one audio file through one AudioPluginHost .filtergraph, offline.
+
+    WaveShaper nodes are built straight from the in-tree processor and get their saved state back,
+    Audio Input/Output become the graph's IO nodes. Anything else in the graph is a plugin we can't
+    load without scanning, so effects are replaced by a pass-through and instruments by silence.
+
+    load() must be called on the message thread. The render itself runs as a ThreadPoolJob, so any
+    number of renderers can share a pool.
+*/
+class GraphRenderer : public juce::ThreadPoolJob
+{
+public:
+    GraphRenderer(const juce::File& graphFile, const juce::File& inputFile, const juce::File& outputFile,
+                  int blockSize, int chunkSize);
+    ~GraphRenderer() override;
+
+    juce::Result load();
+    JobStatus runJob() override;
+
+    const juce::Result& getResult() const { return result; }
+    const juce::StringArray& getWarnings() const { return warnings; }
+    const juce::File& getOutputFile() const { return output; }
+
+    double getAudioSeconds() const { return audioSeconds; }
+    double getRenderSeconds() const { return renderSeconds; }
+
+private:
+    juce::File graphFile, input, output;
+    int blockSize, chunkSize;
+
+    juce::AudioFormatManager formatManager;
+    std::unique_ptr<juce::AudioFormatReader> reader;
+    std::unique_ptr<juce::AudioProcessorGraph> graph;
+
+    juce::Result result{ juce::Result::ok() };
+    juce::StringArray warnings;
+    double audioSeconds = 0, renderSeconds = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(GraphRenderer)
+};
@@ -0,0 +1,228 @@
+/*
+  ==============================================================================
+
+    Main.cpp
+    Created: 19 Oct 2026 5:03:18pm
+    Author:  kylew
+
+    Headless renderer for AudioPluginHost graphs containing WaveShaper.
+
+        GraphRender [--threads=n] [--block=n] [--chunk=n] graph input output [graph input output ...]
+        GraphRender --instantiate=n
+        GraphRender --transpose-benchmark [--block=n]
+        GraphRender --table-benchmark [--block=n]
+        GraphRender --stress[=seconds] [--block=n]
+
+    Each graph/input/output triple is one job. Jobs run concurrently on a thread pool and
+    the throughput of each one is printed when everything has finished.
+
+    --instantiate creates n processors, then opens and paints an editor on each, and prints
+    how long the first one and the rest took. The first includes everything shared.
+
+    --transpose-benchmark finds the channel count where filtering through a channel
+    interleaved block beats filtering one channel after another.
+
+    --table-benchmark times each curve's kernel against its CurveTable lookup. The tables
+    are only built into the plugin with WAVESHAPER_CURVE_TABLES=1.
+
+    --stress plays a hostile host at one processor for a while, 10 seconds unless told
+    otherwise, and exits with 1 if processBlock allocated or put NaN, inf or denormals out.
+    The allocation counting replaces malloc and operator new for the whole binary, so the
+    other modes run on it too; it costs them one thread local check per allocation.
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "GraphRenderer.h"
+#include "TransposeBenchmark.h"
+#include "TableBenchmark.h"
+#include "StressTest.h"
+#include "../../Source/PluginEditor.h"
+
+namespace
+{
+    void printUsage()
+    {
+        std::cout << "Usage: GraphRender [--threads=n] [--block=n] [--chunk=n] graph input output [graph input output ...]" << std::endl
+                  << "       GraphRender --instantiate=n" << std::endl
+                  << "       GraphRender --transpose-benchmark [--block=n]" << std::endl
+                  << "       GraphRender --table-benchmark [--block=n]" << std::endl
+                  << "       GraphRender --stress[=seconds] [--block=n]" << std::endl;
+    }
+
+    void printTimes(const char* what, const juce::Array<double>& seconds)
+    {
+        auto rest = 0.0;
+        for (int i = 1; i < seconds.size(); ++i)
+            rest += seconds[i];
+
+        std::cout << what << ": first " << juce::String(seconds[0] * 1000, 3) << " ms";
+
+        if (seconds.size() > 1)
+            std::cout << ", then " << juce::String(rest * 1000 / (seconds.size() - 1), 3) << " ms on average";
+
+        std::cout << std::endl;
+    }
+
+    //Everything is kept alive until the end, the same as a host with several instances open.
+    void measureInstantiation(int count)
+    {
+        using namespace juce;
+
+        OwnedArray<WaveShaperAudioProcessor> processors;
+        OwnedArray<AudioProcessorEditor> editors;
+        Array<double> construction, editorOpen;
+
+        for (int i = 0; i < count; ++i)
+        {
+            auto start = Time::getHighResolutionTicks();
+            processors.add(new WaveShaperAudioProcessor());
+            construction.add(Time::highResolutionTicksToSeconds(Time::getHighResolutionTicks() - start));
+        }
+
+        for (auto* processor : processors)
+        {
+            auto start = Time::getHighResolutionTicks();
+            auto* editor = editors.add(processor->createEditorIfNeeded());
+
+            Image image(Image::ARGB, editor->getWidth(), editor->getHeight(), true);
+            Graphics g(image);
+            editor->paintEntireComponent(g, false);
+
+            editorOpen.add(Time::highResolutionTicksToSeconds(Time::getHighResolutionTicks() - start));
+        }
+
+        printTimes("Processor construction", construction);
+        printTimes("Editor open and first paint", editorOpen);
+
+        //editors have to go before their processors
+        editors.clear();
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    using namespace juce;
+
+    //the processors and the graph expect a message manager to exist, even though nothing is dispatched
+    ScopedJuceInitialiser_GUI juceInitialiser;
+
+    ArgumentList args(argc, argv);
+
+    if (args.containsOption("--instantiate"))
+    {
+        auto count = args.removeValueForOption("--instantiate").getIntValue();
+
+        if (count < 1)
+        {
+            printUsage();
+            return 1;
+        }
+
+        measureInstantiation(count);
+        return 0;
+    }
+
+    auto numThreads = args.containsOption("--threads") ? args.removeValueForOption("--threads").getIntValue() : SystemStats::getNumCpus();
+    auto blockSize = args.containsOption("--block") ? args.removeValueForOption("--block").getIntValue() : 512;
+    auto chunkSize = args.containsOption("--chunk") ? args.removeValueForOption("--chunk").getIntValue() : 0;
+
+    if (args.containsOption("--transpose-benchmark"))
+    {
+        if (blockSize < 1)
+        {
+            printUsage();
+            return 1;
+        }
+
+        TransposeBenchmark::run(blockSize);
+        return 0;
+    }
+
+    if (args.containsOption("--table-benchmark"))
+    {
+        if (blockSize < 1)
+        {
+            printUsage();
+            return 1;
+        }
+
+        TableBenchmark::run(blockSize);
+        return 0;
+    }
+
+    if (args.containsOption("--stress"))
+    {
+        auto seconds = args.removeValueForOption("--stress").getDoubleValue();
+
+        if (blockSize < 1)
+        {
+            printUsage();
+            return 1;
+        }
+
+        return StressTest::run(seconds > 0 ? seconds : 10, blockSize) ? 0 : 1;
+    }
+
+    if (args.size() == 0 || args.size() % 3 != 0 || numThreads < 1 || blockSize < 1)
+    {
+        printUsage();
+        return 1;
+    }
+
+    OwnedArray<GraphRenderer> renderers;
+
+    for (int i = 0; i < args.size(); i += 3)
+    {
+        auto* renderer = renderers.add(new GraphRenderer(args[i].resolveAsFile(), args[i + 1].resolveAsFile(), args[i + 2].resolveAsFile(),
+                                                         blockSize, chunkSize));
+
+        auto loaded = renderer->load();
+
+        for (auto& warning : renderer->getWarnings())
+            std::cout << args[i].text << ": " << warning << std::endl;
+
+        if (loaded.failed())
+        {
+            std::cerr << loaded.getErrorMessage() << std::endl;
+            return 1;
+        }
+    }
+
+    ThreadPool pool(numThreads);
+    auto start = Time::getHighResolutionTicks();
+
+    for (auto* renderer : renderers)
+        pool.addJob(renderer, false);
+
+    while (pool.getNumJobs() > 0)
+        Thread::sleep(10);
+
+    auto wallSeconds = Time::highResolutionTicksToSeconds(Time::getHighResolutionTicks() - start);
+    auto totalAudioSeconds = 0.0;
+    auto exitCode = 0;
+
+    for (auto* renderer : renderers)
+    {
+        if (renderer->getResult().failed())
+        {
+            std::cerr << renderer->getResult().getErrorMessage() << std::endl;
+            exitCode = 1;
+            continue;
+        }
+
+        totalAudioSeconds += renderer->getAudioSeconds();
+
+        std::cout << renderer->getOutputFile().getFileName() << ": "
+                  << String(renderer->getAudioSeconds(), 2) << " s of audio in "
+                  << String(renderer->getRenderSeconds(), 3) << " s ("
+                  << String(renderer->getAudioSeconds() / jmax(1.0e-9, renderer->getRenderSeconds()), 1) << "x real time)" << std::endl;
+    }
+
+    std::cout << renderers.size() << " jobs on " << numThreads << " threads: "
+              << String(totalAudioSeconds, 2) << " s of audio in " << String(wallSeconds, 3) << " s ("
+              << String(totalAudioSeconds / jmax(1.0e-9, wallSeconds), 1) << "x real time)" << std::endl;
+
+    return exitCode;
+}
@@ -0,0 +1,351 @@
+/*
+  ==============================================================================
+
+    StressTest.cpp
+    Created: 20 Oct 2026 7:12:05am
+    Author:  kylew
+
+  ==============================================================================
+*/
+
+#include "StressTest.h"
+#include "../../Source/PluginProcessor.h"
+
+namespace
+{
+    //Only the thread that sets watching gets its allocations counted, and only while it's set.
+    thread_local bool watching = false;
+    std::atomic<int> numAllocations{ 0 };
+
+    void noteAllocation() noexcept
+    {
+        if (watching)
+            numAllocations.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+//These replace the allocator for the whole GraphRender binary, every mode of it, not just --stress.
+//Outside a stress run watching is never set, so all they add is one thread local check per allocation.
+//
+//AudioBuffer and HeapBlock go straight to malloc, so on Linux that's where allocations are caught;
+//plain operator new ends up there too. Everywhere else only operator new is watched. Aligned new
+//doesn't go through malloc anywhere, so it's replaced on every platform.
+#if JUCE_LINUX
+extern "C"
+{
+    void* __libc_malloc(size_t size);
+    void* __libc_calloc(size_t count, size_t size);
+    void* __libc_realloc(void* pointer, size_t size);
+
+    void* malloc(size_t size)
+    {
+        noteAllocation();
+        return __libc_malloc(size);
+    }
+
+    void* calloc(size_t count, size_t size)
+    {
+        noteAllocation();
+        return __libc_calloc(count, size);
+    }
+
+    void* realloc(void* pointer, size_t size)
+    {
+        noteAllocation();
+        return __libc_realloc(pointer, size);
+    }
+}
+#else
+void* operator new(size_t size)
+{
+    noteAllocation();
+
+    if (auto* pointer = std::malloc(size > 0 ? size : 1))
+        return pointer;
+
+    throw std::bad_alloc();
+}
+
+void* operator new[](size_t size)                { return operator new(size); }
+void operator delete(void* pointer) noexcept           { std::free(pointer); }
+void operator delete[](void* pointer) noexcept         { std::free(pointer); }
+void operator delete(void* pointer, size_t) noexcept   { std::free(pointer); }
+void operator delete[](void* pointer, size_t) noexcept { std::free(pointer); }
+#endif
+
+void* operator new(size_t size, std::align_val_t alignment)
+{
+    noteAllocation();
+    auto bytes = juce::jmax((size_t)1, size);
+
+   #if JUCE_WINDOWS
+    if (auto* pointer = _aligned_malloc(bytes, (size_t)alignment))
+        return pointer;
+   #else
+    void* pointer = nullptr;
+
+    if (posix_memalign(&pointer, juce::jmax(sizeof(void*), (size_t)alignment), bytes) == 0)
+        return pointer;
+   #endif
+
+    throw std::bad_alloc();
+}
+
+void* operator new[](size_t size, std::align_val_t alignment) { return operator new(size, alignment); }
+
+void operator delete(void* pointer, std::align_val_t) noexcept
+{
+   #if JUCE_WINDOWS
+    _aligned_free(pointer);
+   #else
+    std::free(pointer);
+   #endif
+}
+
+void operator delete[](void* pointer, std::align_val_t alignment) noexcept         { operator delete(pointer, alignment); }
+void operator delete(void* pointer, size_t, std::align_val_t alignment) noexcept   { operator delete(pointer, alignment); }
+void operator delete[](void* pointer, size_t, std::align_val_t alignment) noexcept { operator delete(pointer, alignment); }
+
+namespace
+{
+    constexpr int preparedSizes[] { 1, 16, 64, 128, 256, 512, 1024, 2048 };
+    constexpr double sampleRates[] { 44100, 48000, 88200, 96000, 192000 };
+    constexpr int maxPreparedSize = 2048;
+    constexpr int maxOversize = 4; //blocks go up to this many times the prepared size
+
+    //Runs step over and over until it's told to stop.
+    class Worker : public juce::Thread
+    {
+    public:
+        Worker(const juce::String& name, std::function<void(juce::Random&)> stepToRun)
+            : juce::Thread(name), step(std::move(stepToRun))
+        {
+            startThread();
+        }
+
+        ~Worker() override
+        {
+            stopThread(2000);
+        }
+
+        void run() override
+        {
+            juce::Random random;
+
+            while (! threadShouldExit())
+                step(random);
+        }
+
+    private:
+        std::function<void(juce::Random&)> step;
+    };
+
+    struct Failures
+    {
+        int allocations = 0, nans = 0, infs = 0, denormals = 0;
+        juce::String first;
+
+        int total() const { return allocations + nans + infs + denormals; }
+    };
+
+    //Noise at a random level, now and then silence or next to it so the tails decay towards denormals,
+    //and now and then a NaN, inf or huge sample no sane host would send. The processor has to turn those
+    //into silence, bypassed or not. The input itself never holds a denormal: bypass passes the input
+    //through, so any denormal in the output has to be one the processor made.
+    void fillInput(juce::AudioBuffer<float>& buffer, int numSamples, juce::Random& random)
+    {
+        const float levels[] { 0, 1.0e-30f, 1.0e-3f, .5f, 4 };
+        auto level = levels[random.nextInt((int)std::size(levels))];
+
+        for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
+        {
+            auto* data = buffer.getWritePointer(channel);
+
+            for (int s = 0; s < numSamples; ++s)
+            {
+                auto x = level * (random.nextFloat() * 2 - 1);
+                data[s] = std::fpclassify(x) == FP_SUBNORMAL ? 0.f : x;
+            }
+        }
+
+        if (random.nextInt(64) == 0)
+        {
+            const float garbage[] { std::numeric_limits<float>::quiet_NaN(), std::numeric_limits<float>::infinity(), 1.0e30f };
+            buffer.setSample(random.nextInt(buffer.getNumChannels()), random.nextInt(numSamples), garbage[random.nextInt((int)std::size(garbage))]);
+        }
+    }
+}
+
+bool StressTest::run(double seconds, int blockSize)
+{
+    using namespace juce;
+
+    WaveShaperAudioProcessor processor;
+    processor.enableAllBuses(); //the sidechain too
+
+    auto& parameters = processor.getParameters();
+    auto* typeSelect = processor.apvts.getParameter("typeSelect");
+    auto* bypass = processor.apvts.getParameter("bypass");
+
+    Random random(1);
+    auto sampleRate = 48000.0;
+    auto preparedSize = blockSize;
+
+    auto prepare = [&]
+    {
+        processor.releaseResources();
+        processor.setRateAndBufferSizeDetails(sampleRate, preparedSize);
+        processor.prepareToPlay(sampleRate, preparedSize);
+    };
+
+    prepare();
+
+    AudioBuffer<float> buffer(jmax(processor.getTotalNumInputChannels(), processor.getTotalNumOutputChannels()),
+                              jmax(blockSize, maxPreparedSize) * maxOversize);
+    MidiBuffer midi;
+
+    //a host's automation playback, and the message thread saving and restoring sessions, with no regard for
+    //what the audio thread is doing
+    std::atomic<int> numParameterChanges{ 0 }, numStateRoundTrips{ 0 };
+
+    Worker automation("Automation storm", [&](Random& r)
+    {
+        for (int i = 0; i < 64; ++i)
+            parameters.getUnchecked(r.nextInt(parameters.size()))->setValue(r.nextFloat());
+
+        numParameterChanges += 64;
+        Thread::yield();
+    });
+
+    Worker state("State save and restore", [&](Random& r)
+    {
+        MemoryBlock data;
+        processor.getStateInformation(data);
+        processor.setStateInformation(data.getData(), (int)data.getSize());
+
+        ++numStateRoundTrips;
+        Thread::sleep(r.nextInt(5));
+    });
+
+    Failures failures;
+    int64 numCalls = 0, numSamplesProcessed = 0, numOverruns = 0;
+    int numPrepares = 1;
+    double worstCall = 0, worstPerSample = 0, sumPerSample = 0, sumSquaresPerSample = 0;
+    int worstCallSize = 0;
+    auto callsUntilPrepare = 1000 + random.nextInt(3000);
+
+    auto endMs = Time::getMillisecondCounterHiRes() + seconds * 1000;
+
+    while (Time::getMillisecondCounterHiRes() < endMs)
+    {
+        //hosts stop calling processBlock to re-prepare, so this happens between calls on the same thread
+        if (--callsUntilPrepare == 0)
+        {
+            sampleRate = sampleRates[random.nextInt((int)std::size(sampleRates))];
+            preparedSize = preparedSizes[random.nextInt((int)std::size(preparedSizes))];
+            processor.setNonRealtime(random.nextInt(4) == 0);
+            prepare();
+
+            ++numPrepares;
+            callsUntilPrepare = 1000 + random.nextInt(3000);
+        }
+
+        //mostly ordinary sizes, plus a share of single samples, exactly prepared and oversized blocks
+        int numSamples;
+
+        switch (random.nextInt(8))
+        {
+            case 0:  numSamples = 1; break;
+            case 1:  numSamples = preparedSize; break;
+            case 2:  numSamples = preparedSize + 1 + random.nextInt(preparedSize * (maxOversize - 1)); break;
+            default: numSamples = 1 + random.nextInt(preparedSize); break;
+        }
+
+        if (random.nextInt(16) == 0)
+            typeSelect->setValue(random.nextFloat());
+
+        if (random.nextInt(32) == 0)
+            bypass->setValue(bypass->getValue() < .5f ? 1.f : 0.f);
+
+        auto hostBypassed = random.nextInt(64) == 0;
+
+        fillInput(buffer, numSamples, random);
+        AudioBuffer<float> block(buffer.getArrayOfWritePointers(), buffer.getNumChannels(), numSamples);
+
+        auto allocationsBefore = numAllocations.load();
+        watching = true;
+        auto start = Time::getHighResolutionTicks();
+
+        if (hostBypassed)
+            processor.processBlockBypassed(block, midi);
+        else
+            processor.processBlock(block, midi);
+
+        auto callSeconds = Time::highResolutionTicksToSeconds(Time::getHighResolutionTicks() - start);
+        watching = false;
+
+        auto allocations = numAllocations.load() - allocationsBefore;
+        int nans = 0, infs = 0, denormals = 0;
+
+        for (int channel = 0; channel < processor.getTotalNumOutputChannels(); ++channel)
+        {
+            auto* data = block.getReadPointer(channel);
+
+            for (int s = 0; s < numSamples; ++s)
+            {
+                nans += std::isnan(data[s]) ? 1 : 0;
+                infs += std::isinf(data[s]) ? 1 : 0;
+                denormals += std::fpclassify(data[s]) == FP_SUBNORMAL ? 1 : 0;
+            }
+        }
+
+        if (allocations + nans + infs + denormals > 0 && failures.first.isEmpty())
+        {
+            failures.first = "call " + String(numCalls) + ", " + String(numSamples) + " samples prepared for "
+                           + String(preparedSize) + " at " + String(sampleRate) + " Hz"
+                           + (allocations > 0 ? ", allocated" : "") + (nans > 0 ? ", NaN" : "")
+                           + (infs > 0 ? ", inf" : "") + (denormals > 0 ? ", denormal" : "");
+        }
+
+        failures.allocations += allocations;
+        failures.nans += nans;
+        failures.infs += infs;
+        failures.denormals += denormals;
+
+        auto perSample = callSeconds * 1.0e9 / numSamples;
+        sumPerSample += perSample;
+        sumSquaresPerSample += perSample * perSample;
+        worstPerSample = jmax(worstPerSample, perSample);
+
+        if (callSeconds > worstCall)
+        {
+            worstCall = callSeconds;
+            worstCallSize = numSamples;
+        }
+
+        numOverruns += callSeconds > numSamples / sampleRate ? 1 : 0;
+        numSamplesProcessed += numSamples;
+        ++numCalls;
+    }
+
+    auto meanPerSample = sumPerSample / (double)numCalls;
+    auto jitter = std::sqrt(jmax(0.0, sumSquaresPerSample / (double)numCalls - meanPerSample * meanPerSample));
+
+    std::cout << numCalls << " calls, " << numSamplesProcessed << " samples, " << numPrepares << " prepares, "
+              << numParameterChanges.load() << " parameter changes, " << numStateRoundTrips.load() << " state round trips" << std::endl;
+    std::cout << "worst call " << String(worstCall * 1.0e6, 1) << " us (" << worstCallSize << " samples), "
+              << "ns per sample: worst " << String(worstPerSample, 1) << ", mean " << String(meanPerSample, 1)
+              << ", jitter " << String(jitter, 1) << std::endl;
+    std::cout << numOverruns << " calls took longer than the audio they produced" << std::endl;
+    std::cout << "allocations " << failures.allocations << ", NaN " << failures.nans << ", inf " << failures.infs
+              << ", denormals " << failures.denormals << std::endl;
+
+    if (failures.total() > 0)
+    {
+        std::cout << "FAILED, first at " << failures.first << std::endl;
+        return false;
+    }
+
+    std::cout << "passed" << std::endl;
+    return true;
+}
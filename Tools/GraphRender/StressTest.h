@@ -0,0 +1,28 @@
+/*
+  ==============================================================================
+
+    StressTest.h
+    Created: 20 Oct 2026 7:12:05am
+    Author:  kylew
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+//==============================================================================
+/** Plays the worst host we can think of at one WaveShaper for a while. Block sizes jump
+    around between 1 sample and several times the prepared size, typeSelect and bypass get
+    flipped, other threads storm the parameters and save and restore the state, and the
+    processor is re-prepared every so often at a different rate and size.
+
+    Every processBlock call is timed and its output checked. Fails if a call allocated or
+    left NaN, inf or a denormal in the output. Worst case and jitter are only reported,
+    they depend on the machine.
+*/
+namespace StressTest
+{
+    //true if nothing failed
+    bool run(double seconds, int blockSize);
+}
@@ -0,0 +1,98 @@
+/*
+  ==============================================================================
+
+    TableBenchmark.cpp
+    Created: 20 Oct 2026 8:03:44am
+    Author:  kylew
+
+  ==============================================================================
+*/
+
+#include "TableBenchmark.h"
+#include "../../Source/PluginProcessor.h"
+
+namespace
+{
+    constexpr double secondsPerCase = .25;
+
+    //Runs process over a fresh copy of input until secondsPerCase of processing has gone by, returns
+    //nanoseconds per sample. Shaping the same buffer over and over would drift towards the curve's
+    //fixed points, so every pass starts from the original noise and only the process call is timed.
+    template <typename Process>
+    double measure(const std::vector<float>& input, Process&& process)
+    {
+        using namespace juce;
+
+        auto data = input;
+        process(data.data(), (int)data.size()); //warm up the caches and the branch predictor
+
+        int64 numBlocks = 0, ticks = 0;
+        auto budget = (int64)(secondsPerCase * (double)Time::getHighResolutionTicksPerSecond());
+
+        while (ticks < budget)
+        {
+            std::copy(input.begin(), input.end(), data.begin());
+
+            auto start = Time::getHighResolutionTicks();
+            process(data.data(), (int)data.size());
+            ticks += Time::getHighResolutionTicks() - start;
+
+            ++numBlocks;
+        }
+
+        return Time::highResolutionTicksToSeconds(ticks) * 1.0e9 / ((double)numBlocks * (double)input.size());
+    }
+}
+
+void TableBenchmark::run(int blockSize)
+{
+    using namespace juce;
+
+    ScopedNoDenormals noDenormals;
+    Random random(1);
+
+    //full scale noise, inside every table's range, so the lookup is never turned down
+    std::vector<float> input((size_t)blockSize);
+
+    for (auto& x : input)
+        x = random.nextFloat() * 2 - 1;
+
+    std::cout << "Curve tables against kernels, default drive, " << blockSize << " sample blocks, ns per sample" << std::endl;
+    std::cout << "curve                kernel     table" << std::endl;
+
+    auto numTabled = 0, numWins = 0;
+
+    for (int curve = 0; curve < CurveRegistry::numCurves; ++curve)
+    {
+        auto& descriptor = CurveRegistry::getCurve(curve);
+
+        if (descriptor.tableRange <= 0)
+            continue;
+
+        auto key = CurveTableCache::makeKey(curve, descriptor.defaultDrive);
+        auto coefficients = descriptor.prepare(CurveTableCache::getDrive(key));
+        CurveTable::Ptr table = new CurveTable(key, &WaveShaperAudioProcessor::shapeInPlace, descriptor.tableRange);
+
+        ++numTabled;
+        std::cout << String(descriptor.name).paddedRight(' ', 16);
+
+        auto check = input;
+
+        if (! table->process(check.data(), (int)check.size()))
+        {
+            std::cout << "  rejected, misses CurveTable::maxError" << std::endl;
+            continue;
+        }
+
+        auto kernelTime = measure(input, [&](float* data, int numSamples) { descriptor.process(data, numSamples, coefficients); });
+        auto tableTime = measure(input, [&](float* data, int numSamples) { table->process(data, numSamples); });
+
+        numWins += tableTime < kernelTime ? 1 : 0;
+
+        std::cout << String(kernelTime, 3).paddedLeft(' ', 11)
+                  << String(tableTime, 3).paddedLeft(' ', 10)
+                  << (tableTime < kernelTime ? "  table" : "") << std::endl;
+    }
+
+    std::cout << "The table is faster for " << numWins << " of " << numTabled << " curves" << std::endl;
+}
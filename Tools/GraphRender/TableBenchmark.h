@@ -0,0 +1,23 @@
+/*
+  ==============================================================================
+
+    TableBenchmark.h
+    Created: 20 Oct 2026 8:03:44am
+    Author:  kylew
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+//==============================================================================
+/** Times every curve that has a table range two ways at its default drive: its kernel, and
+    a CurveTable lookup, range check included. Prints the cost per sample of each and which
+    curves the table wins on. Builds with WAVESHAPER_CURVE_TABLES=1 are only worth it if
+    this says so on the target machine.
+*/
+namespace TableBenchmark
+{
+    void run(int blockSize);
+}
@@ -0,0 +1,158 @@
+/*
+  ==============================================================================
+
+    TransposeBenchmark.cpp
+    Created: 20 Oct 2026 4:40:51am
+    Author:  kylew
+
+  ==============================================================================
+*/
+
+#include "TransposeBenchmark.h"
+#include "../../Source/EmphasisFilter.h"
+
+namespace
+{
+    constexpr double sampleRate = 48000;
+    constexpr float emphasisGain = 9, emphasisFrequency = 1000;
+    constexpr double secondsPerCase = .25;
+
+    //The same two biquads EmphasisFilter::processPre runs, one channel at a time.
+    class PlanarCascade
+    {
+    public:
+        PlanarCascade(int numChannels) : states((size_t)numChannels)
+        {
+            using Coefficients = juce::dsp::IIR::ArrayCoefficients<float>;
+
+            auto boost = juce::Decibels::decibelsToGain(emphasisGain);
+            auto shelfCut = juce::Decibels::decibelsToGain(-emphasisGain * .5f);
+
+            setStage(0, Coefficients::makePeakFilter(sampleRate, emphasisFrequency, .7f, boost));
+            setStage(1, Coefficients::makeHighShelf(sampleRate, emphasisFrequency * 4, juce::MathConstants<float>::sqrt2 * .5f, shelfCut));
+        }
+
+        void process(const juce::dsp::AudioBlock<float>& block) noexcept
+        {
+            for (size_t channel = 0; channel < block.getNumChannels(); ++channel)
+            {
+                auto* data = block.getChannelPointer(channel);
+                auto local = states[channel];
+
+                for (size_t s = 0; s < block.getNumSamples(); ++s)
+                {
+                    auto x = data[s];
+
+                    for (int i = 0; i < EmphasisFilter::numStages; ++i)
+                    {
+                        auto& k = stages[(size_t)i];
+                        auto& state = local[(size_t)i];
+
+                        auto y = k[0] * x + state[0];
+                        state[0] = k[1] * x - k[3] * y + state[1];
+                        state[1] = k[2] * x - k[4] * y;
+                        x = y;
+                    }
+
+                    data[s] = x;
+                }
+
+                states[channel] = local;
+            }
+        }
+
+    private:
+        void setStage(int index, const std::array<float, 6>& coefficients)
+        {
+            auto a0 = 1 / coefficients[3];
+            stages[(size_t)index] = { coefficients[0] * a0, coefficients[1] * a0, coefficients[2] * a0, coefficients[4] * a0, coefficients[5] * a0 };
+        }
+
+        std::array<std::array<float, 5>, EmphasisFilter::numStages> stages{};
+        std::vector<std::array<std::array<float, 2>, EmphasisFilter::numStages>> states;
+    };
+
+    //Runs process over a fresh copy of input until secondsPerCase of processing has gone by, returns nanoseconds
+    //per channel-sample. The +9 dB peak would grow a buffer that was processed over and over until it
+    //turned into inf and NaN, so every pass starts from the original noise and only the process call is timed.
+    template <typename Process>
+    double measure(const juce::AudioBuffer<float>& input, Process&& process)
+    {
+        using namespace juce;
+
+        AudioBuffer<float> buffer(input.getNumChannels(), input.getNumSamples());
+        auto block = dsp::AudioBlock<float>(buffer);
+
+        buffer.makeCopyOf(input, true);
+        process(block); //warm up the caches and the branch predictor
+
+        int64 numBlocks = 0, ticks = 0;
+        auto budget = (int64)(secondsPerCase * (double)Time::getHighResolutionTicksPerSecond());
+
+        while (ticks < budget)
+        {
+            buffer.makeCopyOf(input, true);
+
+            auto start = Time::getHighResolutionTicks();
+            process(block);
+            ticks += Time::getHighResolutionTicks() - start;
+
+            ++numBlocks;
+        }
+
+        return Time::highResolutionTicksToSeconds(ticks) * 1.0e9 / ((double)numBlocks * input.getNumChannels() * input.getNumSamples());
+    }
+}
+
+void TransposeBenchmark::run(int blockSize)
+{
+    using namespace juce;
+
+    ScopedNoDenormals noDenormals;
+    Random random(1);
+
+    std::cout << "Emphasis cascade, " << blockSize << " sample blocks, " << ChannelInterleavedBlock::lanes
+              << " lanes, ns per channel-sample" << std::endl;
+    std::cout << "channels    planar  interleaved  transposes" << std::endl;
+
+    auto breakEven = 0;
+
+    for (auto numChannels : { 1, 2, 3, 4, 6, 8, 12, 16, 24, 32, 64 })
+    {
+        AudioBuffer<float> buffer(numChannels, blockSize);
+
+        for (int channel = 0; channel < numChannels; ++channel)
+            for (int s = 0; s < blockSize; ++s)
+                buffer.setSample(channel, s, random.nextFloat() * 2 - 1);
+
+        PlanarCascade planar(numChannels);
+
+        EmphasisFilter emphasis;
+        emphasis.prepare(sampleRate, numChannels, blockSize);
+        emphasis.setParameters(emphasisGain, emphasisFrequency);
+
+        ChannelInterleavedBlock transposeOnly;
+        transposeOnly.prepare(numChannels, blockSize);
+
+        auto planarTime = measure(buffer, [&](const dsp::AudioBlock<float>& block) { planar.process(block); });
+        auto interleavedTime = measure(buffer, [&](const dsp::AudioBlock<float>& block) { emphasis.processPre(block); });
+        auto transposeTime = measure(buffer, [&](const dsp::AudioBlock<float>& block)
+            {
+                transposeOnly.interleave(block);
+                transposeOnly.deinterleave(block);
+            });
+
+        if (breakEven == 0 && interleavedTime < planarTime)
+            breakEven = numChannels;
+
+        std::cout << String(numChannels).paddedLeft(' ', 8)
+                  << String(planarTime, 3).paddedLeft(' ', 10)
+                  << String(interleavedTime, 3).paddedLeft(' ', 13)
+                  << String(transposeTime, 3).paddedLeft(' ', 12) << std::endl;
+    }
+
+    if (breakEven > 0)
+        std::cout << "Interleaved is faster from " << breakEven << " channels" << std::endl;
+    else
+        std::cout << "Interleaved never caught up" << std::endl;
+}
@@ -0,0 +1,23 @@
+/*
+  ==============================================================================
+
+    TransposeBenchmark.h
+    Created: 20 Oct 2026 4:40:51am
+    Author:  kylew
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+//==============================================================================
+/** Times the emphasis cascade two ways over a range of channel counts: scalar, one channel
+    after another on the planar buffer, and through a ChannelInterleavedBlock, transposes
+    included. Prints the cost per channel-sample of each and the channel count where the
+    interleaved layout starts to win.
+*/
+namespace TransposeBenchmark
+{
+    void run(int blockSize);
+}
@@ -0,0 +1,147 @@
+/*
+  ==============================================================================
+
+    Main.cpp
+    Created: 19 Oct 2026 10:51:36pm
+    Author:  kylew
+
+    Prints the telemetry every running WaveShaper instance on this machine publishes.
+
+        TelemetryReader [--watch=seconds]
+
+    Only reads the mapped files, so it can't disturb the audio threads it's watching.
+    Files left behind by a process that crashed are deleted, files whose process has stopped
+    publishing are reported as stale and skipped, and a slot caught halfway through a write
+    that never finished is reported as torn.
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "../../Source/Telemetry.h"
+
+namespace
+{
+    //a file whose newest slot is older than this probably belongs to a dead process
+    constexpr juce::int64 staleTimeMs = 30000;
+
+    void printUsage()
+    {
+        std::cout << "Usage: TelemetryReader [--watch=seconds]" << std::endl;
+    }
+
+    juce::String formatMs(double seconds)
+    {
+        return juce::String(seconds * 1000.0, 3) + " ms";
+    }
+
+    void printSnapshot(const juce::File& file, int slot, const Telemetry::Snapshot& data)
+    {
+        auto mean = data.blockCount > 0 ? data.totalBlockSeconds / (double)data.blockCount : 0.0;
+        auto idleMs = juce::Time::currentTimeMillis() - data.lastUpdateMs;
+
+        std::cout << file.getFileNameWithoutExtension() << "/" << slot
+                  << "  " << (data.curve >= 0 ? data.curveName : "-")
+                  << "  blocks " << (juce::int64)data.blockCount
+                  << "  mean " << formatMs(mean)
+                  << "  max " << formatMs(data.maxBlockSeconds)
+                  << "  overruns " << (juce::int64)data.overruns
+                  << "  in " << juce::String(data.inputRms[0], 1) << "/" << juce::String(data.inputRms[1], 1) << " dB"
+                  << "  out " << juce::String(data.outputRms[0], 1) << "/" << juce::String(data.outputRms[1], 1) << " dB"
+                  << "  clips " << (juce::int64)data.inputClips << "/" << (juce::int64)data.outputClips
+                  << (idleMs > 1000 ? "  (idle)" : "") << std::endl;
+    }
+
+    //returns the number of live instances found in the file
+    int printFile(const juce::File& file)
+    {
+        if (Telemetry::isOrphaned(file))
+        {
+            std::cout << file.getFileName() << (Telemetry::removeFile(file) ? ": left by a dead process, removed" : ": left by a dead process, skipped") << std::endl;
+            return 0;
+        }
+
+        juce::MemoryMappedFile mapping(file, juce::MemoryMappedFile::readOnly, false);
+
+        if (mapping.getData() == nullptr || mapping.getSize() < sizeof(Telemetry::Header))
+            return 0;
+
+        auto* header = static_cast<const Telemetry::Header*>(mapping.getData());
+
+        if (header->magic != Telemetry::magic || header->version != Telemetry::version || header->slotSize != sizeof(Telemetry::Slot)
+            || mapping.getSize() < sizeof(Telemetry::Header) + header->numSlots * sizeof(Telemetry::Slot))
+        {
+            std::cout << file.getFileName() << ": unknown layout, skipped" << std::endl;
+            return 0;
+        }
+
+        auto* slots = reinterpret_cast<const Telemetry::Slot*>(static_cast<const char*>(mapping.getData()) + sizeof(Telemetry::Header));
+
+        std::vector<std::pair<int, Telemetry::Snapshot>> live;
+        juce::int64 newest = 0;
+
+        for (int i = 0; i < (int)header->numSlots; ++i)
+        {
+            Telemetry::Snapshot data;
+            auto result = Telemetry::read(slots[i], data);
+
+            if (result == Telemetry::ReadResult::valid)
+            {
+                live.emplace_back(i, data);
+                newest = juce::jmax(newest, data.lastUpdateMs);
+            }
+            else if (result == Telemetry::ReadResult::torn)
+            {
+                std::cout << file.getFileNameWithoutExtension() << "/" << i << "  torn, skipped" << std::endl;
+            }
+        }
+
+        if (! live.empty() && juce::Time::currentTimeMillis() - newest > staleTimeMs)
+        {
+            std::cout << file.getFileName() << ": stale, skipped" << std::endl;
+            return 0;
+        }
+
+        for (auto& entry : live)
+            printSnapshot(file, entry.first, entry.second);
+
+        return (int)live.size();
+    }
+
+    void printAll()
+    {
+        auto files = Telemetry::getFolder().findChildFiles(juce::File::findFiles, false, "*.telemetry");
+        auto numInstances = 0;
+
+        for (auto& file : files)
+            numInstances += printFile(file);
+
+        std::cout << numInstances << " instance(s) in " << files.size() << " process(es)" << std::endl;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    using namespace juce;
+
+    ArgumentList args(argc, argv);
+
+    auto watchSeconds = args.containsOption("--watch") ? args.removeValueForOption("--watch").getDoubleValue() : 0.0;
+
+    if (args.size() != 0 || watchSeconds < 0)
+    {
+        printUsage();
+        return 1;
+    }
+
+    printAll();
+
+    while (watchSeconds > 0)
+    {
+        Thread::sleep(roundToInt(watchSeconds * 1000.0));
+        std::cout << std::endl;
+        printAll();
+    }
+
+    return 0;
+}